@@ -11,12 +11,42 @@ BENCHMARK(bench_DivideAndConquer)
     ->Range(10, 1000'000)
     ->Complexity(benchmark::oNLogN);
 
+BENCHMARK(bench_DivideAndConquer_par)
+    ->RangeMultiplier(10)
+    ->Range(10, 10'000'000)
+    ->Complexity(benchmark::oNLogN);
+
 BENCHMARK(bench_Iterative)
     ->RangeMultiplier(10)
     ->Range(10, 1000'000)
     ->Complexity(benchmark::oNLogN);
 
+BENCHMARK(bench_Plan)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000'000)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Plan_split)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000'000)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Real)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000'000)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_RealPlan)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000'000)
+    ->Complexity(benchmark::oNLogN);
+
 #ifdef WITH_FFTW3
+BENCHMARK(bench_FFTW_r2c)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000'000)
+    ->Complexity(benchmark::oNLogN);
+
 BENCHMARK(bench_FFTW)
     ->RangeMultiplier(10)
     ->Range(10, 1000'000)
@@ -8,7 +8,27 @@ BENCHMARK(bench_BruteForce)
 
 BENCHMARK(bench_InPlace)
     ->RangeMultiplier(8)
-    ->Range(1 << 5, 1 << 20)
+    ->Range(1 << 5, 1 << 28)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Stockham)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 23)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Radix4)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 23)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Radix4_split)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 23)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_SplitRadix)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 23)
     ->Complexity(benchmark::oNLogN);
 
 BENCHMARK(bench_DivideAndConquer)
@@ -21,7 +41,93 @@ BENCHMARK(bench_Iterative)
     ->Range(1 << 5, 1 << 20)
     ->Complexity(benchmark::oNLogN);
 
+BENCHMARK(bench_BitReverse)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 23)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK(bench_BitReverse_incremental)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 23)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK(bench_Plan)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 28)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Plan_split)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 28)
+    ->Complexity(benchmark::oNLogN);
+
+// past the last-level cache
+BENCHMARK(bench_FourStep)
+    ->RangeMultiplier(4)
+    ->Range(1 << 20, 1 << 28)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_SixStep)
+    ->RangeMultiplier(4)
+    ->Range(1 << 20, 1 << 28)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Radix4_par)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 23)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Plan_par)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 23)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Real)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 20)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_RealPlan)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 20)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_RealInverse)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 20)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_NTT_mint)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 24)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_NTT_InPlace)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 24)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_NTT_Plan)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 24)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_IntegerConvolution)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Complexity(benchmark::oNLogN);
+
 #ifdef WITH_FFTW3
+BENCHMARK(bench_FFTW_r2c)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 20)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_FFTW_c2r)
+    ->RangeMultiplier(8)
+    ->Range(1 << 5, 1 << 20)
+    ->Complexity(benchmark::oNLogN);
+
 BENCHMARK(bench_FFTW)
     ->RangeMultiplier(8)
     ->Range(1 << 5, 1 << 20)
@@ -17,7 +17,7 @@ BENCHMARK(bench_DivideAndConquer)
     ->Arg(809)
     ->Arg(1009)
     ->Arg(10009)
-    ->Complexity(benchmark::oNSquared);
+    ->Complexity(benchmark::oNLogN);
 
 BENCHMARK(bench_Iterative)
     ->Arg(109)
@@ -26,7 +26,34 @@ BENCHMARK(bench_Iterative)
     ->Arg(809)
     ->Arg(1009)
     ->Arg(10009)
-    ->Complexity(benchmark::oNSquared);
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Bluestein)
+    ->Arg(109)
+    ->Arg(211)
+    ->Arg(401)
+    ->Arg(809)
+    ->Arg(1009)
+    ->Arg(10009)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK(bench_Rader)
+    ->Arg(109)
+    ->Arg(211)
+    ->Arg(401)
+    ->Arg(809)
+    ->Arg(1009)
+    ->Arg(10009)
+    ->Complexity(benchmark::oAuto);
+
+BENCHMARK(bench_Plan)
+    ->Arg(109)
+    ->Arg(211)
+    ->Arg(401)
+    ->Arg(809)
+    ->Arg(1009)
+    ->Arg(10009)
+    ->Complexity(benchmark::oNLogN);
 
 #ifdef WITH_FFTW3
 BENCHMARK(bench_FFTW)
@@ -1,4 +1,6 @@
+#include <atomic>
 #include <complex>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <random>
@@ -10,6 +12,8 @@
 #include <benchmark/benchmark.h>
 
 #include <fftx/1d.hpp>
+#include <fftx/batch.hpp>
+#include <fftx/plan.hpp>
 #include <fftx/primitives.hpp>
 
 typedef std::complex<double> cd;
@@ -19,6 +23,51 @@ std::default_random_engine gen;
 std::uniform_real_distribution<double> distribution;
 std::array<cd, 1000> out;
 
+// every allocation of the program, the fixed-size kernels must not make any.
+// The replacements are not inlined: GCC would see free() on the pointers of
+// operator new and warn (-Wmismatched-new-delete).
+std::atomic<long long> allocations{0};
+
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// allocations per iteration since before, reported as the counter allocs
+void count_allocations(benchmark::State& state, long long before)
+{
+    state.counters["allocs"] = benchmark::Counter(
+        allocations - before, benchmark::Counter::kAvgIterations);
+}
+
 auto random_vec(size_t N)
 {
     std::vector<cd> V(N);
@@ -31,45 +80,142 @@ template <std::size_t n>
 void bench_Power2(benchmark::State& state)
 {
     const auto data = random_vec(n);
+    const long long before = allocations;
     for (auto _ : state)
     {
         fftx::FFT_Power2_fixed<n>(
             data.begin(), out.begin(),
             cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
     }
+    count_allocations(state, before);
 }
 
 template <std::size_t n>
 void bench_handwritten(benchmark::State& state)
 {
     const auto in = random_vec(n);
+    const long long before = allocations;
     for (auto _ : state)
     {
         fftx::FFT_Handwritten_fixed<n>(in.begin(), out.begin(),
                                        cd(cos(2 * PI / n), -sin(2 * PI / n)));
     }
+    count_allocations(state, before);
 }
 template <std::size_t n>
 void bench_BruteForce(benchmark::State& state)
 {
     auto data = random_vec(n);
+    const long long before = allocations;
     for (auto _ : state)
     {
         fftx::FFT_BruteForce_fixed<n>(
             data.begin(), out.begin(),
             cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
     }
+    count_allocations(state, before);
 }
 template <std::size_t n>
 void bench_Iterative(benchmark::State& state)
 {
     auto data = random_vec(n);
+    const long long before = allocations;
     for (auto _ : state)
     {
         fftx::FFT_Iterative_fixed<n>(
             data.begin(), out.begin(),
             cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
     }
+    count_allocations(state, before);
+}
+
+template <std::size_t n>
+void bench_Codelet(benchmark::State& state)
+{
+    auto data = random_vec(n);
+    const long long before = allocations;
+    for (auto _ : state)
+    {
+        fftx::FFT_Codelet_fixed<n>(data.begin(), out.begin(),
+                                   cd(cos(2 * PI / n), -sin(2 * PI / n)));
+    }
+    count_allocations(state, before);
+}
+
+template <std::size_t n>
+void bench_Fixed(benchmark::State& state)
+{
+    auto data = random_vec(n);
+    const long long before = allocations;
+    for (auto _ : state)
+    {
+        fftx::FFT_fixed<n>(data.begin(), out.begin(),
+                           cd(cos(2 * PI / n), -sin(2 * PI / n)));
+    }
+    count_allocations(state, before);
+}
+
+// FFT_fixed with the size known at run time, through the jump table
+void bench_FixedRuntime(benchmark::State& state)
+{
+    const int n = state.range(0);
+    const auto data = random_vec(n);
+    const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+    const long long before = allocations;
+    for (auto _ : state)
+    {
+        std::copy(data.begin(), data.end(), out.begin());
+        fftx::FFT_fixed(out.begin(), out.begin() + n, e);
+    }
+    count_allocations(state, before);
+}
+
+// batches of batch_count transforms of size n, stored one after the other
+constexpr int batch_count = 4096;
+
+template <std::size_t n>
+void bench_Batch_fixed(benchmark::State& state)
+{
+    auto data = random_vec(n * batch_count);
+    const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+    for (auto _ : state)
+        fftx::FFT_Batch_fixed<n>(data.begin(), batch_count, 1, n, e);
+    state.SetItemsProcessed(state.iterations() * batch_count);
+}
+
+// the baseline of bench_Batch_fixed: one kernel call per transform
+template <std::size_t n>
+void bench_Loop_fixed(benchmark::State& state)
+{
+    auto data = random_vec(n * batch_count);
+    const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+    for (auto _ : state)
+        for (int b = 0; b < batch_count; ++b)
+            fftx::detail::fixed_kernel<n>(data.begin() + b * n, e);
+    state.SetItemsProcessed(state.iterations() * batch_count);
+}
+
+template <std::size_t n>
+void bench_BatchPlan(benchmark::State& state)
+{
+    auto data = random_vec(n * batch_count);
+    fftx::batch_plan<double> P(n, batch_count, 1, n,
+                               cd(cos(2 * PI / n), -sin(2 * PI / n)));
+    for (auto _ : state)
+        P.forward(data.begin());
+    state.SetItemsProcessed(state.iterations() * batch_count);
+}
+
+// the baseline of bench_BatchPlan: one plan execution per transform
+template <std::size_t n>
+void bench_LoopPlan(benchmark::State& state)
+{
+    auto data = random_vec(n * batch_count);
+    fftx::plan<cd> P(n, cd(cos(2 * PI / n), -sin(2 * PI / n)));
+    for (auto _ : state)
+        for (int b = 0; b < batch_count; ++b)
+            P.forward(data.begin() + b * n, data.begin() + (b + 1) * n);
+    state.SetItemsProcessed(state.iterations() * batch_count);
 }
 
 #ifdef WITH_FFTW3
@@ -122,6 +268,9 @@ BENCHMARK_TEMPLATE(bench_Power2, 4);
 BENCHMARK_TEMPLATE(bench_Power2, 8);
 BENCHMARK_TEMPLATE(bench_Power2, 16);
 BENCHMARK_TEMPLATE(bench_Power2, 32);
+BENCHMARK_TEMPLATE(bench_Power2, 64);
+BENCHMARK_TEMPLATE(bench_Power2, 128);
+BENCHMARK_TEMPLATE(bench_Power2, 256);
 
 BENCHMARK_TEMPLATE(bench_handwritten, 2);
 BENCHMARK_TEMPLATE(bench_handwritten, 3);
@@ -145,6 +294,50 @@ BENCHMARK_TEMPLATE(bench_Iterative, 5);
 BENCHMARK_TEMPLATE(bench_Iterative, 6);
 BENCHMARK_TEMPLATE(bench_Iterative, 7);
 BENCHMARK_TEMPLATE(bench_Iterative, 8);
+BENCHMARK_TEMPLATE(bench_Iterative, 12);
+BENCHMARK_TEMPLATE(bench_Iterative, 16);
+BENCHMARK_TEMPLATE(bench_Iterative, 30);
+BENCHMARK_TEMPLATE(bench_Iterative, 32);
+BENCHMARK_TEMPLATE(bench_Iterative, 60);
+BENCHMARK_TEMPLATE(bench_Iterative, 64);
+
+BENCHMARK_TEMPLATE(bench_Codelet, 2);
+BENCHMARK_TEMPLATE(bench_Codelet, 3);
+BENCHMARK_TEMPLATE(bench_Codelet, 4);
+BENCHMARK_TEMPLATE(bench_Codelet, 5);
+BENCHMARK_TEMPLATE(bench_Codelet, 6);
+BENCHMARK_TEMPLATE(bench_Codelet, 7);
+BENCHMARK_TEMPLATE(bench_Codelet, 8);
+BENCHMARK_TEMPLATE(bench_Codelet, 12);
+BENCHMARK_TEMPLATE(bench_Codelet, 16);
+BENCHMARK_TEMPLATE(bench_Codelet, 30);
+BENCHMARK_TEMPLATE(bench_Codelet, 32);
+BENCHMARK_TEMPLATE(bench_Codelet, 60);
+BENCHMARK_TEMPLATE(bench_Codelet, 64);
+
+BENCHMARK_TEMPLATE(bench_Fixed, 4);
+BENCHMARK_TEMPLATE(bench_Fixed, 7);
+BENCHMARK_TEMPLATE(bench_Fixed, 16);
+BENCHMARK_TEMPLATE(bench_Fixed, 30);
+BENCHMARK_TEMPLATE(bench_Fixed, 64);
+BENCHMARK_TEMPLATE(bench_Fixed, 96);
+BENCHMARK_TEMPLATE(bench_Fixed, 128);
+BENCHMARK_TEMPLATE(bench_Fixed, 256);
+BENCHMARK(bench_FixedRuntime)->DenseRange(2, 16)->Arg(30)->Arg(64);
+
+BENCHMARK_TEMPLATE(bench_Batch_fixed, 4);
+BENCHMARK_TEMPLATE(bench_Batch_fixed, 7);
+BENCHMARK_TEMPLATE(bench_Batch_fixed, 16);
+BENCHMARK_TEMPLATE(bench_Batch_fixed, 64);
+BENCHMARK_TEMPLATE(bench_Loop_fixed, 4);
+BENCHMARK_TEMPLATE(bench_Loop_fixed, 7);
+BENCHMARK_TEMPLATE(bench_Loop_fixed, 16);
+BENCHMARK_TEMPLATE(bench_Loop_fixed, 64);
+
+BENCHMARK_TEMPLATE(bench_BatchPlan, 64);
+BENCHMARK_TEMPLATE(bench_BatchPlan, 256);
+BENCHMARK_TEMPLATE(bench_LoopPlan, 64);
+BENCHMARK_TEMPLATE(bench_LoopPlan, 256);
 
 #ifdef WITH_FFTW3
 BENCHMARK_TEMPLATE(bench_FFTW, 2);
@@ -154,8 +347,12 @@ BENCHMARK_TEMPLATE(bench_FFTW, 5);
 BENCHMARK_TEMPLATE(bench_FFTW, 6);
 BENCHMARK_TEMPLATE(bench_FFTW, 7);
 BENCHMARK_TEMPLATE(bench_FFTW, 8);
+BENCHMARK_TEMPLATE(bench_FFTW, 12);
 BENCHMARK_TEMPLATE(bench_FFTW, 16);
+BENCHMARK_TEMPLATE(bench_FFTW, 30);
 BENCHMARK_TEMPLATE(bench_FFTW, 32);
+BENCHMARK_TEMPLATE(bench_FFTW, 60);
+BENCHMARK_TEMPLATE(bench_FFTW, 64);
 #endif
 
 #ifdef WITH_ALGLIB
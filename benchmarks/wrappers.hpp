@@ -11,6 +11,8 @@
 
 #include <fftx.hpp>
 
+#include "../examples/modulo.h"
+
 typedef std::complex<double> cd;
 const double PI = acos(-1.0);
 using fft_type = decltype(fftx::FFT_BruteForce<cd>);
@@ -42,7 +44,74 @@ void bench_InPlace(benchmark::State& state)
     auto data = random_vec(state.range(0));
     for (auto _ : state)
     {
-        fftx::FFT_InPlace<cd>(
+        fftx::FFT_InPlace(
+            data.begin(), data.end(),
+            cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_Stockham(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::FFT_Stockham<cd>(
+            data, cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_Radix4(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::FFT_Radix4<cd>(
+            data, cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_Radix4_split(benchmark::State& state)
+{
+    auto data = fftx::to_split(random_vec(state.range(0)));
+    for (auto _ : state)
+    {
+        fftx::FFT_Radix4_split(
+            data, cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_SplitRadix(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::FFT_SplitRadix<cd>(
+            data, cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_Bluestein(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::FFT_Bluestein<cd>(
+            data, cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_Rader(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::FFT_Rader<cd>(
             data, cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
     }
     state.SetComplexityN(state.range(0));
@@ -58,6 +127,19 @@ void bench_DivideAndConquer(benchmark::State& state)
     }
     state.SetComplexityN(state.range(0));
 }
+// all the hardware threads
+void bench_DivideAndConquer_par(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::FFT_DivideAndConquer(
+            fftx::execution::par, data,
+            cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
 void bench_Iterative(benchmark::State& state)
 {
     auto data = random_vec(state.range(0));
@@ -69,6 +151,266 @@ void bench_Iterative(benchmark::State& state)
     state.SetComplexityN(state.range(0));
 }
 
+void bench_BitReverse(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::bit_reverse_permutation(data.begin(), data.end());
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_BitReverse_incremental(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::bit_reverse_incremental(data.begin(), data.end());
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_Plan(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    fftx::plan<cd> P(data.size(),
+                     cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    for (auto _ : state)
+    {
+        P.forward(data.begin(), data.end());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_Plan_split(benchmark::State& state)
+{
+    auto data = fftx::to_split(random_vec(state.range(0)));
+    fftx::plan<cd> P(data.size(),
+                     cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    for (auto _ : state)
+    {
+        P.forward_split(data.re.begin(), data.re.end(), data.im.begin());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_FourStep(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    fftx::four_step_plan<cd> P(
+        data.size(), cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    for (auto _ : state)
+    {
+        P.forward(data.begin(), data.end());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_SixStep(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    fftx::four_step_plan<cd> P(
+        data.size(), cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())),
+        true);
+    for (auto _ : state)
+    {
+        P.forward(data.begin(), data.end());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+// all the hardware threads
+void bench_Radix4_par(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    for (auto _ : state)
+    {
+        fftx::FFT_Radix4(
+            fftx::execution::par, data.begin(), data.end(),
+            cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_Plan_par(benchmark::State& state)
+{
+    auto data = random_vec(state.range(0));
+    fftx::plan<cd> P(data.size(),
+                     cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    for (auto _ : state)
+    {
+        P.forward(fftx::execution::par, data.begin(), data.end());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+auto random_real_vec(size_t N)
+{
+    std::vector<double> V(N);
+    for (auto& x : V)
+        x = distribution(gen);
+    return V;
+}
+
+void bench_Real(benchmark::State& state)
+{
+    auto data = random_real_vec(state.range(0));
+    std::vector<cd> out(data.size() / 2 + 1);
+    for (auto _ : state)
+    {
+        fftx::FFT_Real(
+            data.begin(), data.end(), out.begin(),
+            cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_RealPlan(benchmark::State& state)
+{
+    auto data = random_real_vec(state.range(0));
+    std::vector<cd> out(data.size() / 2 + 1);
+    fftx::real_plan<double> P(
+        data.size(), cd(cos(2 * PI / data.size()), -sin(2 * PI / data.size())));
+    for (auto _ : state)
+    {
+        P.forward(data.begin(), data.end(), out.begin());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_RealInverse(benchmark::State& state)
+{
+    std::vector<double> data(state.range(0));
+    auto H = random_vec(data.size() / 2 + 1);
+    for (auto _ : state)
+    {
+        fftx::FFT_RealInverse(
+            H.begin(), data.begin(), data.end(),
+            cd(cos(2 * PI / data.size()), sin(2 * PI / data.size())));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+// number-theoretic transforms modulo 5 2^25 + 1
+using mint = my_modulo_lib::mint<
+    my_modulo_lib::field_modulo<long long, 167772161>>;
+using mod = fftx::mod32<167772161>;
+
+template <class M>
+auto random_mod_vec(size_t N)
+{
+    std::vector<M> V(N);
+    for (auto& x : V)
+        x = M((long long)(distribution(gen) * 167772161));
+    return V;
+}
+
+void bench_NTT_mint(benchmark::State& state)
+{
+    auto data = random_mod_vec<mint>(state.range(0));
+    const mint e((long long)mod::root_of_unity(data.size()).value());
+    for (auto _ : state)
+    {
+        fftx::FFT_InPlace(data.begin(), data.end(), e);
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_NTT_InPlace(benchmark::State& state)
+{
+    auto data = random_mod_vec<mod>(state.range(0));
+    const mod e = mod::root_of_unity(data.size());
+    for (auto _ : state)
+    {
+        fftx::FFT_InPlace(data.begin(), data.end(), e);
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_NTT_Plan(benchmark::State& state)
+{
+    auto data = random_mod_vec<mod>(state.range(0));
+    fftx::ntt_plan<mod> P(data.size());
+    for (auto _ : state)
+    {
+        P.forward(data.begin(), data.end());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_IntegerConvolution(benchmark::State& state)
+{
+    __extension__ typedef __int128 i128;
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<long long> U(-(1LL << 40), 1LL << 40);
+    std::vector<long long> a(state.range(0)), b(state.range(0));
+    for (auto& x : a)
+        x = U(gen);
+    for (auto& x : b)
+        x = U(gen);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            fftx::integer_convolution<i128>(fftx::execution::par, a, b));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+#ifdef WITH_FFTW3
+void bench_FFTW_r2c(benchmark::State& state)
+{
+    auto data = random_real_vec(state.range(0));
+    double* in;
+    fftw_complex* out;
+    fftw_plan p;
+    in = (double*)fftw_malloc(sizeof(double) * data.size());
+    out = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) *
+                                     (data.size() / 2 + 1));
+
+    for (std::size_t i = 0; i < data.size(); ++i)
+        in[i] = data[i];
+    p = fftw_plan_dft_r2c_1d(data.size(), in, out, FFTW_ESTIMATE);
+    for (auto _ : state)
+    {
+        fftw_execute(p);
+    }
+    fftw_free(in);
+    fftw_free(out);
+    fftw_destroy_plan(p);
+    state.SetComplexityN(state.range(0));
+}
+
+void bench_FFTW_c2r(benchmark::State& state)
+{
+    const int n = state.range(0);
+    auto H = random_vec(n / 2 + 1);
+    fftw_complex* in;
+    double* out;
+    fftw_plan p;
+    in = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * H.size());
+    out = (double*)fftw_malloc(sizeof(double) * n);
+
+    // FFTW_ESTIMATE does not overwrite the input while planning
+    p = fftw_plan_dft_c2r_1d(n, in, out, FFTW_ESTIMATE);
+    for (std::size_t i = 0; i < H.size(); ++i)
+    {
+        in[i][0] = H[i].real();
+        in[i][1] = H[i].imag();
+    }
+    for (auto _ : state)
+    {
+        fftw_execute(p);
+    }
+    fftw_free(in);
+    fftw_free(out);
+    fftw_destroy_plan(p);
+    state.SetComplexityN(state.range(0));
+}
+#endif
+
 #ifdef WITH_FFTW3
 void bench_FFTW(benchmark::State& state)
 {
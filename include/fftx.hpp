@@ -1,4 +1,11 @@
 #pragma once
 
 #include <fftx/1d.hpp>
+#include <fftx/batch.hpp>
+#include <fftx/fourstep.hpp>
 #include <fftx/nd.hpp>
+#include <fftx/ntt.hpp>
+#include <fftx/outofcore.hpp>
+#include <fftx/plan.hpp>
+#include <fftx/real.hpp>
+#include <fftx/split.hpp>
@@ -2,12 +2,19 @@
 
 #include <algorithm>
 #include <complex>
-#include <fftw3.h>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <fftx/exception.hpp>
+#include <fftx/execution.hpp>
 #include <fftx/math.hpp>
+#include <fftx/ntt.hpp>
+#include <fftx/permutation.hpp>
 #include <fftx/primitives.hpp>
+#include <fftx/scheduler.hpp>
+#include <fftx/simd.hpp>
 
 namespace fftx
 {
@@ -39,12 +46,17 @@ namespace fftx
 
         return B;
     }
+
     /*
         In-place FFT
         !!! n must be a power of 2 and e must be and n-root of unity (of the
         identity)
         ie.
         for any x: x = e^n * x
+
+        For std::complex<double> and std::complex<float> in contiguous memory
+        the butterflies are vectorized, see simd.hpp. The modular integers of
+        modular.hpp run the lazy butterflies of ntt.hpp.
     */
 
     template <class iter, class T>
@@ -58,49 +70,1330 @@ namespace fftx
         if (n == 1)
             return;
 
-        const T _1 = power(e, n);
+        if constexpr (detail::is_modular<T>::value)
+        {
+            bit_reverse_permutation(first, last);
+            return detail::ntt_dit(first, n, detail::ntt_twiddles<T>(e, n));
+        }
+
         T f = power(e, n / 2);
-        int nbits = 0;
         std::vector<T> e2{e};
-        for (int m = n / 2; m > 0; m >>= 1, ++nbits)
+        for (int m = n / 2; m > 0; m >>= 1)
             e2.push_back(e2.back() * e2.back());
 
         std::reverse(e2.begin(), e2.end());
 
-        iter _i = first;
-        for (int i = 0; i < n; ++i, ++_i)
-        {
-            int ib = i, j = 0;
-            iter _j = first;
-
-            for (int b = 0; b < nbits; ib >>= 1, ++b)
-                j = (j << 1) | (ib & 1);
+        bit_reverse_permutation(first, last);
 
-            std::advance(_j, j);
+        // the vectorized butterflies read a table of twiddles, whose
+        // construction is not paid off by the smaller sizes
+        constexpr int simd_threshold = 512;
+        if constexpr (detail::use_simd<iter>::value)
+            if (n >= simd_threshold)
+            {
+                const auto tw = detail::stage_twiddles(e, n);
+                for (int h = 1; h < n; h <<= 1)
+                    for (int i = 0; i < n; i += 2 * h)
+                        detail::radix2_butterflies(&first[i], &first[i + h],
+                                                   &tw[h], h);
+                return;
+            }
 
-            if (i < j)
-                std::swap(*_i, *_j);
-        }
         for (int len = 2, k = 1; len <= n; len <<= 1, ++k)
         {
             for (int i = 0; i < n; i += len)
             {
-                T ej = _1;
-                for (int j = 0; j < len / 2; ++j)
+                {
+                    // j=0
+                    iter u = first + i, v = first + i + len / 2;
+                    T Bu = *u, Bv = *v;
+                    *u = Bu + Bv;
+                    *v = detail::minus(Bu, Bv, f);
+                }
+                T ej = e2[k];
+                for (int j = 1; j < len / 2; ++j)
                 {
                     iter u = first + i + j, v = first + i + j + len / 2;
                     T Bu = *u, Bv = *v * ej;
                     *u = Bu + Bv;
-                    *v = Bu + Bv * f;
+                    *v = detail::minus(Bu, Bv, f);
                     ej *= e2[k];
                 }
             }
         }
     }
+
+    /*
+        In-place FFT with an execution policy, see execution.hpp.
+        The parallel version reads the twiddles from the table
+        stage_twiddles(e, n), the n/2 butterflies of every pass are split
+        into contiguous ranges, one per thread. The sizes below
+        parallel_threshold run serially.
+    */
+    template <class policy, class iter, class T>
+    typename std::enable_if<execution::is_execution_policy<policy>::value,
+                            void>::type
+    FFT_InPlace(const policy& pol, iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        if (n < parallel_threshold)
+            return FFT_InPlace(first, last, e);
+        if (__builtin_popcount(n) != 1)
+            throw std::runtime_error(std::string(__func__) +
+                                     " n=" + std::to_string(n) +
+                                     " must be a power of 2");
+
+        constexpr int grain = 1 << 12;
+        const auto tw = detail::stage_twiddles(e, n);
+        const T f = tw[0];
+        bit_reverse_permutation(first, last, pol);
+
+        for (int h = 1; h < n; h <<= 1)
+        {
+            // butterfly t is the butterfly j = t % h of the block t / h
+            detail::parallel_for(pol, n / 2, grain, [&](int t, int t_last) {
+                for (int i = t / h, j = t % h; t < t_last; ++i, j = 0)
+                {
+                    const int l = std::min(h, j + t_last - t);
+                    iter u = first + 2 * h * i, v = u + h;
+                    const T* w = &tw[h];
+                    if constexpr (detail::use_simd<iter>::value)
+                        detail::radix2_butterflies(&u[j], &v[j], w + j, l - j);
+                    else
+                        for (int k = j; k < l; ++k)
+                        {
+                            const T a = u[k], b = v[k] * w[k];
+                            u[k] = a + b;
+                            v[k] = detail::minus(a, b, f);
+                        }
+                    t += l - j;
+                }
+            });
+        }
+    }
+
+    namespace detail
+    {
+        /*
+            One pass of the Stockham algorithm, on sub-sequences of length
+            len interleaved with stride s = n/len:
+            out[q + s*2p]     = in[q + s*p] + in[q + s*(p+len/2)]
+            out[q + s*(2p+1)] = (in[q + s*p] - in[q + s*(p+len/2)]) * e^(p*s)
+        */
+        template <class iter1, class iter2, class T>
+        void stockham_pass(iter1 in,
+                           iter2 out,
+                           const int len,
+                           const int s,
+                           const std::vector<T>& W,
+                           const T f)
+        {
+            const int m = len / 2;
+            for (int p = 0; p < m; ++p)
+            {
+                const T& wp = W[p * s];
+                iter1 x0 = in + s * p, x1 = in + s * (p + m);
+                iter2 y0 = out + s * 2 * p, y1 = out + s * (2 * p + 1);
+                for (int q = 0; q < s; ++q)
+                {
+                    T a = x0[q], b = x1[q];
+                    y0[q] = a + b;
+                    y1[q] = detail::minus(a, b, f) * wp;
+                }
+            }
+        }
+    }  // namespace detail
+
+    /*
+        Stockham autosort FFT.
+        The passes alternate between the input range and a scratch buffer,
+        the output is produced in natural order and no bit reversal is
+        needed. Every pass reads and writes contiguous runs of the data.
+        !!! n must be a power of 2 and e must be and n-root of unity (of the
+        identity)
+    */
+    template <class iter, class T>
+    void FFT_Stockham(iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        if (__builtin_popcount(n) != 1)
+            throw std::runtime_error(std::string(__func__) +
+                                     " n=" + std::to_string(n) +
+                                     " must be a power of 2");
+        if (n == 1)
+            return;
+
+        const T f = power(e, n / 2);
+        const auto W = root_powers(e, n, n / 2);
+        std::vector<T> buff(n);
+
+        bool in_buff = false;
+        for (int len = n, s = 1; len > 1; len >>= 1, s <<= 1)
+        {
+            if (in_buff)
+                detail::stockham_pass(buff.begin(), first, len, s, W, f);
+            else
+                detail::stockham_pass(first, buff.begin(), len, s, W, f);
+            in_buff = !in_buff;
+        }
+        if (in_buff)
+            std::copy(buff.begin(), buff.end(), first);
+    }
+
+    namespace detail
+    {
+        /*
+            The butterflies k_first <= k < k_last of the radix-4 pass that
+            merges the four transforms of length m from x0, with
+            wb = &tw[m], wc = &tw[2m], J = e^(n/4) and f = e^(n/2).
+        */
+        template <class iter, class T>
+        void radix4_range(iter x0,
+                          const int m,
+                          const T* wb,
+                          const T* wc,
+                          const T J,
+                          const T f,
+                          int k_first,
+                          const int k_last)
+        {
+            iter x1 = x0 + m, x2 = x1 + m, x3 = x2 + m;
+            if constexpr (use_simd<iter>::value)
+            {
+                const int k = k_first;
+                radix4_butterflies(&x0[k], &x1[k], &x2[k], &x3[k], wb + k,
+                                   wc + k, k_last - k, J);
+                return;
+            }
+            if (k_first == 0)
+            {
+                T a = x0[0], b = x1[0], c = x2[0], d = x3[0];
+                T apb = a + b, amb = minus(a, b, f);
+                T cpd = c + d, cmd = minus(c, d, f);
+                T jcmd = mul_j(J, cmd);
+                x0[0] = apb + cpd;
+                x1[0] = amb + jcmd;
+                x2[0] = minus(apb, cpd, f);
+                x3[0] = minus(amb, jcmd, f);
+                ++k_first;
+            }
+            for (int k = k_first; k < k_last; ++k)
+            {
+                T a = x0[k], b = x1[k] * wb[k], c = x2[k] * wc[k],
+                  d = x3[k] * (wb[k] * wc[k]);
+                T apb = a + b, amb = minus(a, b, f);
+                T cpd = c + d, cmd = minus(c, d, f);
+                T jcmd = mul_j(J, cmd);
+                x0[k] = apb + cpd;
+                x1[k] = amb + jcmd;
+                x2[k] = minus(apb, cpd, f);
+                x3[k] = minus(amb, jcmd, f);
+            }
+        }
+
+        /*
+            Radix-4 in-place FFT of size n, with the table
+            tw = stage_twiddles(e, n), see FFT_Radix4.
+            With a parallel policy, the n/4 butterflies of every pass are
+            split into contiguous ranges, one per thread, which are whole
+            blocks in the first passes and parts of a block in the last.
+        */
+        template <class policy, class iter, class T>
+        void radix4(const policy& pol,
+                    iter first,
+                    const int n,
+                    const std::vector<T>& tw)
+        {
+            if (n == 1)
+                return;
+
+            // butterflies per thread, at least
+            constexpr int grain = 1 << 11;
+
+            const T f = tw[0];
+            bit_reverse_permutation(first, first + n, pol);
+
+            int m = 1;
+            if (__builtin_ctz(n) % 2)
+            {
+                parallel_for(pol, n / 2, grain, [&](int j_first, int j_last) {
+                    for (int i = 2 * j_first; i < 2 * j_last; i += 2)
+                    {
+                        T a = first[i], b = first[i + 1];
+                        first[i] = a + b;
+                        first[i + 1] = minus(a, b, f);
+                    }
+                });
+                m = 2;
+            }
+            if (m == n)
+                return;
+
+            const T J = tw[3];  // e^(n/4)
+            for (; m < n; m *= 4)
+            {
+                // e^(2ks) = tw[m + k], e^(ks) = tw[2m + k], s = n/4m
+                const T *wb = &tw[m], *wc = &tw[2 * m];
+                // butterfly t is the butterfly k = t % m of the block t / m
+                parallel_for(pol, n / 4, grain, [&](int t, const int t_last) {
+                    for (int i = t / m, k = t % m; t < t_last; ++i, k = 0)
+                    {
+                        const int l = std::min(m, k + t_last - t);
+                        radix4_range(first + 4 * m * i, m, wb, wc, J, f, k, l);
+                        t += l - k;
+                    }
+                });
+            }
+        }
+
+        template <class iter, class T>
+        void radix4(iter first, const int n, const std::vector<T>& tw)
+        {
+            radix4(execution::seq, first, n, tw);
+        }
+    }  // namespace detail
+
+    /*
+        Radix-4 in-place FFT.
+        After the bit reversal, every pass merges four transforms of length m
+        into one of length 4m, so there are half as many passes over the
+        data as in FFT_InPlace, and each butterfly of four points needs three
+        twiddle multiplications and one product with the 4-root of unity
+        e^(n/4), which is a swap for the complex numbers. If log2(n) is odd
+        the first pass is radix-2.
+        For std::complex<double> and std::complex<float> in contiguous memory
+        the butterflies are vectorized, see simd.hpp.
+        !!! n must be a power of 2 and e must be and n-root of unity (of the
+        identity)
+    */
+    template <class iter, class T>
+    void FFT_Radix4(iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        if (__builtin_popcount(n) != 1)
+            throw std::runtime_error(std::string(__func__) +
+                                     " n=" + std::to_string(n) +
+                                     " must be a power of 2");
+        detail::radix4(first, n, detail::stage_twiddles(e, n));
+    }
+
+    /*
+        Radix-4 in-place FFT with an execution policy, see execution.hpp.
+        The sizes below parallel_threshold run serially.
+    */
+    template <class policy, class iter, class T>
+    typename std::enable_if<execution::is_execution_policy<policy>::value,
+                            void>::type
+    FFT_Radix4(const policy& pol, iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        if (n < parallel_threshold)
+            return FFT_Radix4(first, last, e);
+        if (__builtin_popcount(n) != 1)
+            throw std::runtime_error(std::string(__func__) +
+                                     " n=" + std::to_string(n) +
+                                     " must be a power of 2");
+        detail::radix4(pol, first, n, detail::stage_twiddles(e, n));
+    }
+
+    namespace detail
+    {
+        /*
+            Radix-4 butterflies of radix4_split, for k < m, on the quarters
+            r0..r3 and i0..i3 of the real and imaginary parts. The quarters
+            do not overlap: restrict lets the compiler vectorize the loop.
+        */
+        template <class R>
+        void radix4_split_butterflies(R* __restrict r0,
+                                      R* __restrict r1,
+                                      R* __restrict r2,
+                                      R* __restrict r3,
+                                      R* __restrict i0,
+                                      R* __restrict i1,
+                                      R* __restrict i2,
+                                      R* __restrict i3,
+                                      const R* __restrict wbr,
+                                      const R* __restrict wbi,
+                                      const R* __restrict wcr,
+                                      const R* __restrict wci,
+                                      const int m,
+                                      const R s)
+        {
+            for (int k = 0; k < m; ++k)
+            {
+                const R wdr = wbr[k] * wcr[k] - wbi[k] * wci[k];
+                const R wdi = wbr[k] * wci[k] + wbi[k] * wcr[k];
+
+                const R ar = r0[k], ai = i0[k];
+                const R br = r1[k] * wbr[k] - i1[k] * wbi[k];
+                const R bi = r1[k] * wbi[k] + i1[k] * wbr[k];
+                const R cr = r2[k] * wcr[k] - i2[k] * wci[k];
+                const R ci = r2[k] * wci[k] + i2[k] * wcr[k];
+                const R dr = r3[k] * wdr - i3[k] * wdi;
+                const R di = r3[k] * wdi + i3[k] * wdr;
+
+                const R apbr = ar + br, apbi = ai + bi;
+                const R ambr = ar - br, ambi = ai - bi;
+                const R cpdr = cr + dr, cpdi = ci + di;
+                const R jr = s * (di - ci), ji = s * (cr - dr);
+
+                r0[k] = apbr + cpdr;
+                i0[k] = apbi + cpdi;
+                r1[k] = ambr + jr;
+                i1[k] = ambi + ji;
+                r2[k] = apbr - cpdr;
+                i2[k] = apbi - cpdi;
+                r3[k] = ambr - jr;
+                i3[k] = ambi - ji;
+            }
+        }
+
+        /*
+            First pass of radix4_split, m = 1: the twiddles are 1, the
+            butterflies of the blocks of 4 are vectorized across the blocks.
+        */
+        template <class R>
+        void radix4_split_first(R* __restrict re,
+                                R* __restrict im,
+                                const int n,
+                                const R s)
+        {
+            for (int i = 0; i < n; i += 4)
+            {
+                const R apbr = re[i] + re[i + 1], apbi = im[i] + im[i + 1];
+                const R ambr = re[i] - re[i + 1], ambi = im[i] - im[i + 1];
+                const R cpdr = re[i + 2] + re[i + 3];
+                const R cpdi = im[i + 2] + im[i + 3];
+                const R jr = s * (im[i + 3] - im[i + 2]);
+                const R ji = s * (re[i + 2] - re[i + 3]);
+
+                re[i] = apbr + cpdr;
+                im[i] = apbi + cpdi;
+                re[i + 1] = ambr + jr;
+                im[i + 1] = ambi + ji;
+                re[i + 2] = apbr - cpdr;
+                im[i + 2] = apbi - cpdi;
+                re[i + 3] = ambr - jr;
+                im[i + 3] = ambi - ji;
+            }
+        }
+
+        /*
+            Radix-2 butterflies of the last pass of radix4_split, for k < m:
+            u, v = u + w v, u - w v
+        */
+        template <class R>
+        void radix2_split_butterflies(R* __restrict r0,
+                                      R* __restrict r1,
+                                      R* __restrict i0,
+                                      R* __restrict i1,
+                                      const R* __restrict wr,
+                                      const R* __restrict wi,
+                                      const int m)
+        {
+            for (int k = 0; k < m; ++k)
+            {
+                const R vr = r1[k] * wr[k] - i1[k] * wi[k];
+                const R vi = r1[k] * wi[k] + i1[k] * wr[k];
+                r1[k] = r0[k] - vr;
+                i1[k] = i0[k] - vi;
+                r0[k] += vr;
+                i0[k] += vi;
+            }
+        }
+
+        /*
+            Radix-4 in-place FFT of size n on split complex data, with the
+            real and imaginary parts of tw = stage_twiddles(e, n) in twr and
+            twi. The butterflies are real operations on contiguous arrays,
+            which the compiler vectorizes without shuffles: the first pass
+            across the blocks, the others along them. When log2(n) is odd
+            the radix-4 passes transform the two halves, which a last
+            radix-2 pass merges with long contiguous loops.
+            !!! re and im must address contiguous memory (pointers or
+            iterators of std::vector)
+        */
+        template <class iter, class R>
+        void radix4_split(iter re,
+                          iter im,
+                          const int n,
+                          const std::vector<R>& twr,
+                          const std::vector<R>& twi)
+        {
+            if (n == 1)
+                return;
+
+            bit_reverse_permutation_split(re, re + n, im);
+
+            R *r = &re[0], *q = &im[0];
+            // the size of the radix-4 transforms
+            const int n4 = __builtin_ctz(n) % 2 ? n / 2 : n;
+            // j (c - d) = s (-Im(c - d), Re(c - d)), j = s i = e^(n/4)
+            const R s = n >= 4 && twi[3] < 0 ? -1 : 1;
+            if (n4 >= 4)
+                radix4_split_first(r, q, n, s);
+            for (int m = 4; m < n4; m *= 4)
+            {
+                const R *wbr = &twr[m], *wbi = &twi[m];
+                const R *wcr = &twr[2 * m], *wci = &twi[2 * m];
+                for (int i = 0; i < n; i += 4 * m)
+                    radix4_split_butterflies(r + i, r + i + m, r + i + 2 * m,
+                                             r + i + 3 * m, q + i, q + i + m,
+                                             q + i + 2 * m, q + i + 3 * m, wbr,
+                                             wbi, wcr, wci, m, s);
+            }
+            if (n4 < n)
+                radix2_split_butterflies(r, r + n4, q, q + n4, &twr[n4],
+                                         &twi[n4], n4);
+        }
+
+        /*
+            real and imaginary parts of stage_twiddles(e, n)
+        */
+        template <class R>
+        std::pair<std::vector<R>, std::vector<R>> stage_twiddles_split(
+            const std::complex<R> e,
+            const int n)
+        {
+            const auto w = stage_twiddles(e, n);
+            std::pair<std::vector<R>, std::vector<R>> tw;
+            tw.first.resize(w.size());
+            tw.second.resize(w.size());
+            for (std::size_t k = 0; k < w.size(); ++k)
+            {
+                tw.first[k] = w[k].real();
+                tw.second[k] = w[k].imag();
+            }
+            return tw;
+        }
+    }  // namespace detail
+
+    /*
+        Radix-4 in-place FFT on split complex data: the real parts in
+        [re_first, re_last) and the imaginary parts from im_first, both
+        contiguous.
+        !!! n must be a power of 2 and e must be and n-root of unity
+    */
+    template <class iter, class R>
+    void FFT_Radix4_split(iter re_first,
+                          iter re_last,
+                          iter im_first,
+                          const std::complex<R> e)
+    {
+        const int n = std::distance(re_first, re_last);
+        if (__builtin_popcount(n) != 1)
+            throw std::runtime_error(std::string(__func__) +
+                                     " n=" + std::to_string(n) +
+                                     " must be a power of 2");
+        const auto tw = detail::stage_twiddles_split(e, n);
+        detail::radix4_split(re_first, im_first, n, tw.first, tw.second);
+    }
+
+    namespace detail
+    {
+        /*
+            Split-radix step, out of place:
+            out[0..n) = FT of in[0], in[s], ..., in[(n-1)s]
+            with the root of unity e^t, W[k] = e^k
+        */
+        template <class iter1, class iter2, class T>
+        void split_radix(iter1 in,
+                         const int s,
+                         iter2 out,
+                         const int n,
+                         const std::vector<T>& W,
+                         const int t,
+                         const T J,
+                         const T f)
+        {
+            if (n == 1)
+            {
+                out[0] = in[0];
+                return;
+            }
+            if (n == 2)
+            {
+                T a = in[0], b = in[s];
+                out[0] = a + b;
+                out[1] = minus(a, b, f);
+                return;
+            }
+            const int m = n / 4;
+            // U = FT(even), Z = FT(x[4i+1]), Z' = FT(x[4i+3])
+            split_radix(in, 2 * s, out, 2 * m, W, 2 * t, J, f);
+            split_radix(in + s, 4 * s, out + 2 * m, m, W, 4 * t, J, f);
+            split_radix(in + 3 * s, 4 * s, out + 3 * m, m, W, 4 * t, J, f);
+
+            for (int k = 0; k < m; ++k)
+            {
+                T a = out[2 * m + k], b = out[3 * m + k];
+                if (k)
+                {
+                    a = a * W[k * t];
+                    b = b * W[3 * k * t];
+                }
+                T U0 = out[k], U1 = out[k + m];
+                T apb = a + b, jamb = mul_j(J, minus(a, b, f));
+                out[k] = U0 + apb;
+                out[k + 2 * m] = minus(U0, apb, f);
+                out[k + m] = U1 + jamb;
+                out[k + 3 * m] = minus(U1, jamb, f);
+            }
+        }
+    }  // namespace detail
+
+    /*
+        Split-radix FFT.
+        A transform of length n is split into one of length n/2 (the even
+        terms) and two of length n/4, it uses the least number of
+        multiplications among the power of two algorithms.
+        !!! n must be a power of 2 and e must be and n-root of unity (of the
+        identity)
+    */
+    template <class iter, class T>
+    void FFT_SplitRadix(iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        if (__builtin_popcount(n) != 1)
+            throw std::runtime_error(std::string(__func__) +
+                                     " n=" + std::to_string(n) +
+                                     " must be a power of 2");
+        if (n == 1)
+            return;
+
+        const T f = power(e, n / 2);
+        const T J = n >= 4 ? power(e, n / 4) : f;
+        const auto W = root_powers(e, n, std::max(1, 3 * n / 4));
+        const std::vector<T> A(first, last);
+
+        detail::split_radix(A.begin(), 1, first, n, W, 1, J, f);
+    }
+
+    /*
+        Sizes whose largest prime factor is above this threshold are
+        computed with Bluestein's algorithm, when T is a complex type.
+    */
+    constexpr int bluestein_threshold = 37;
+
+    /*
+        Prime radices above this threshold are computed with Rader's
+        algorithm, when T has a subtraction.
+    */
+    constexpr int rader_threshold = 13;
+
+    namespace detail
+    {
+        /*
+            Precomputed tables of Bluestein's algorithm for size n.
+            With s^2 = e and jk = (j^2 + k^2 - (k-j)^2)/2
+            X_k = s^(k^2) sum_j (x_j s^(j^2)) s^(-(k-j)^2)
+            the FT is a cyclic convolution of length m >= 2n-1, m a power of
+            two, which is computed with FFT_Radix4.
+            T must be a complex type.
+        */
+        template <class T>
+        class bluestein
+        {
+            using R = typename real_part<T>::type;
+
+            int n, m;
+            std::vector<T> tw, tw_inv;    // twiddles of the FTs of size m
+            std::vector<R> tw_re, tw_im;  // tw, for the split data
+            std::vector<T> chirp;         // s^(k^2), k < n
+            std::vector<T> kernel;        // FT of s^(-l^2), scaled by 1/m
+            std::vector<T> work;
+
+           public:
+            bluestein(int n_, const T e) : n{n_}, m{1}
+            {
+                while (m < 2 * n - 1)
+                    m <<= 1;
+
+                const R pi = std::acos(R(-1));
+                const T em = std::polar(R(1), -2 * pi / m);
+                tw = stage_twiddles(em, m);
+                tw_inv = stage_twiddles(std::conj(em), m);
+                for (const T w : tw)
+                {
+                    tw_re.push_back(w.real());
+                    tw_im.push_back(w.imag());
+                }
+
+                // s^(k^2) = s^(k^2 mod 2n), because s^(2n) = e^n = 1
+                const R theta = std::arg(e) / 2;
+                chirp.resize(n);
+                for (long long k = 0; k < n; ++k)
+                    chirp[k] = std::polar(R(1), theta * (k * k % (2 * n)));
+
+                kernel.assign(m, T(0));
+                for (int l = 0; l < n; ++l)
+                {
+                    kernel[l] = std::conj(chirp[l]) / R(m);
+                    if (l)
+                        kernel[m - l] = kernel[l];
+                }
+                radix4(kernel.begin(), m, tw);
+                work.resize(m);
+            }
+
+            template <class iter, class policy = execution::sequenced_policy>
+            void operator()(iter first, const policy& pol = {})
+            {
+                constexpr int grain = 1 << 13;
+                parallel_for(pol, m, grain, [&](int k_first, int k_last) {
+                    for (int j = k_first; j < std::min(k_last, n); ++j)
+                        work[j] = first[j] * chirp[j];
+                    for (int j = std::max(k_first, n); j < k_last; ++j)
+                        work[j] = T(0);
+                });
+
+                radix4(pol, work.begin(), m, tw);
+                parallel_for(pol, m, grain, [&](int k_first, int k_last) {
+                    for (int k = k_first; k < k_last; ++k)
+                        work[k] *= kernel[k];
+                });
+                radix4(pol, work.begin(), m, tw_inv);
+
+                parallel_for(pol, n, grain, [&](int k_first, int k_last) {
+                    for (int k = k_first; k < k_last; ++k)
+                        first[k] = work[k] * chirp[k];
+                });
+            }
+
+            /*
+                The same FT on split complex data, serially, with the FTs of
+                size m of radix4_split. The scratch holds the real parts
+                then the imaginary parts, and the inverse FT of size m is
+                the forward one with the real and imaginary parts exchanged.
+            */
+            template <class iter>
+            void split(iter re, iter im)
+            {
+                R* wr = reinterpret_cast<R*>(work.data());
+                R* wi = wr + m;
+                for (int j = 0; j < n; ++j)
+                {
+                    const R c = chirp[j].real(), d = chirp[j].imag();
+                    wr[j] = re[j] * c - im[j] * d;
+                    wi[j] = re[j] * d + im[j] * c;
+                }
+                std::fill(wr + n, wr + m, R(0));
+                std::fill(wi + n, wi + m, R(0));
+
+                radix4_split(wr, wi, m, tw_re, tw_im);
+                for (int k = 0; k < m; ++k)
+                {
+                    const R c = kernel[k].real(), d = kernel[k].imag();
+                    const R a = wr[k], b = wi[k];
+                    wr[k] = a * c - b * d;
+                    wi[k] = a * d + b * c;
+                }
+                radix4_split(wi, wr, m, tw_re, tw_im);
+
+                for (int k = 0; k < n; ++k)
+                {
+                    const R c = chirp[k].real(), d = chirp[k].imag();
+                    re[k] = wr[k] * c - wi[k] * d;
+                    im[k] = wr[k] * d + wi[k] * c;
+                }
+            }
+        };
+
+        /*
+            true if T is complex and n has a prime factor above the
+            bluestein_threshold
+        */
+        template <class T>
+        bool use_bluestein(int n)
+        {
+            if constexpr (is_complex<T>::value)
+                return n > 1 && prime_factorization(n).back() >
+                                    bluestein_threshold;
+            else
+                return false;
+        }
+    }  // namespace detail
+
+    /*
+        Bluestein's (chirp-z) algorithm, the FT of any size n in
+        O(n log(n)) operations.
+        !!! T must be a complex type and e an n-root of unity
+    */
+    template <class iter, class T>
+    void FFT_Bluestein(iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        if (n == 1)
+            return;
+        detail::bluestein<T>(n, e)(first);
+    }
+
+    /*
+        Bluestein's algorithm.
+        !!! T must be a complex type
+
+        Wrapper
+    */
+    template <class T>
+    std::vector<T> FFT_Bluestein(const std::vector<T>& A, const T e)
+    {
+        std::vector<T> B(A);
+        FFT_Bluestein(B.begin(), B.end(), e);
+        return B;
+    }
+
+    namespace detail
+    {
+        /*
+            Radices of the mixed-radix algorithm: the prime factors of n with
+            the pairs of 2 merged into 4.
+        */
+        inline std::vector<int> radices(int n)
+        {
+            std::vector<int> R;
+            int twos = 0;
+            for (auto p : prime_factorization(n))
+            {
+                if (p == 2)
+                    ++twos;
+                else
+                    R.push_back(p);
+            }
+            if (twos % 2)
+                R.insert(R.begin(), 2);
+            R.insert(R.begin(), twos / 2, 4);
+            return R;
+        }
+
+        /*
+            Digit reversal permutation for the radices R:
+            perm[i] is the position of the input i in the first stage.
+            The digits of i are counted in mixed radix and the reversed index
+            is updated with the carries, in O(1) amortized operations.
+        */
+        inline std::vector<int> digit_reversal(int n, const std::vector<int>& R)
+        {
+            const int m = R.size();
+            // weight of the digit d of i in the reversed index
+            std::vector<int> weight(m), digit(m, 0);
+            for (int d = 0, w = n; d < m; ++d)
+                weight[d] = w /= R[d];
+
+            std::vector<int> perm(n);
+            for (int i = 0, j = 0; i < n; ++i)
+            {
+                perm[i] = j;
+                for (int d = 0; d < m; ++d)
+                {
+                    j += weight[d];
+                    if (++digit[d] < R[d])
+                        break;
+                    digit[d] = 0;
+                    j -= R[d] * weight[d];
+                }
+            }
+            return perm;
+        }
+
+        /*
+            One stage of the mixed-radix algorithm with a radix p codelet.
+            The sub-transforms of length len_old found at in + i + k*len_old,
+            k=0..p-1, are merged into one of length len = p*len_old:
+            for r < len_old and q < p
+            out[i + q*len_old + r] = sum_k (in[i + k*len_old + r] * w^(r*k)) *
+                                     e_p^(q*k)
+            with w = e^(n/len), e_p = e^(n/p) and W[k] = e^k.
+        */
+        template <std::size_t p, class iter1, class iter2, class T>
+        void radix_stage_fixed(iter1 in,
+                               iter2 out,
+                               const int n,
+                               const int len_old,
+                               const std::vector<T>& W)
+        {
+            const int len = len_old * p, s = n / len;
+            const T ep = W[n / p];
+            std::array<T, p> x;
+            for (int i = 0; i < n; i += len)
+            {
+                iter1 a = in + i;
+                iter2 b = out + i;
+                {
+                    // r=0, the twiddles are trivial
+                    for (std::size_t k = 0; k < p; ++k)
+                        x[k] = a[k * len_old];
+                    FFT_Handwritten_fixed<p>(x.begin(), x.begin(), ep);
+                    for (std::size_t q = 0; q < p; ++q)
+                        b[q * len_old] = x[q];
+                }
+                for (int r = 1; r < len_old; ++r)
+                {
+                    x[0] = a[r];
+                    for (std::size_t k = 1; k < p; ++k)
+                        x[k] = T(a[k * len_old + r]) * W[s * r * k];
+                    FFT_Handwritten_fixed<p>(x.begin(), x.begin(), ep);
+                    for (std::size_t q = 0; q < p; ++q)
+                        b[q * len_old + r] = x[q];
+                }
+            }
+        }
+
+        /*
+            Karatsuba product of the polynomials a and b of size n:
+            out[0..2n-1) = a * b
+            scratch must have room for 8n elements.
+        */
+        template <class T>
+        void karatsuba(const T* a, const T* b, const int n, T* out, T* scratch)
+        {
+            if (n <= 16)
+            {
+                for (int i = 0; i < 2 * n - 1; ++i)
+                    out[i] = T(0);
+                for (int i = 0; i < n; ++i)
+                    for (int j = 0; j < n; ++j)
+                        out[i + j] += a[i] * b[j];
+                return;
+            }
+            // a = a0 + x^h a1, b = b0 + x^h b1
+            const int h = (n + 1) / 2, l = n - h;
+            T *sa = scratch, *sb = sa + h, *z1 = sb + h, *rest = z1 + 2 * h;
+
+            karatsuba(a, b, h, out, rest);                 // a0 b0
+            karatsuba(a + h, b + h, l, out + 2 * h, rest);  // a1 b1
+            out[2 * h - 1] = T(0);
+
+            for (int i = 0; i < h; ++i)
+            {
+                sa[i] = i < l ? a[i] + a[h + i] : a[i];
+                sb[i] = i < l ? b[i] + b[h + i] : b[i];
+            }
+            karatsuba(sa, sb, h, z1, rest);
+
+            // (a0 + a1)(b0 + b1) - a0 b0 - a1 b1
+            for (int i = 0; i < 2 * h - 1; ++i)
+                z1[i] = T(z1[i] - out[i]);
+            for (int i = 0; i < 2 * l - 1; ++i)
+                z1[i] = T(z1[i] - out[2 * h + i]);
+            for (int i = 0; i < 2 * h - 1; ++i)
+                out[h + i] += z1[i];
+        }
+
+        /*
+            FT of prime size p, for the radices without a codelet.
+
+            For large p Rader's algorithm is used: with g a primitive root
+            modulo p, a_r = x_(g^r) and c_m = e^(g^-m)
+            X_0 = sum_j x_j
+            X_(g^-q) = x_0 + sum_r a_r c_(q-r)
+            the FT is a cyclic convolution of length p-1, computed with
+            Karatsuba's algorithm which works in any ring. The other sizes
+            are evaluated with Horner's rule.
+
+            The input is read from x[0..p) and the output written to
+            x[p..2p).
+        */
+        template <class T>
+        class prime_dft
+        {
+            int p;
+            bool rader;
+            std::vector<T> Wp;            // e^k, k < p
+            std::vector<int> gpow, ginv;  // g^r and g^-r modulo p
+            std::vector<T> c, a, lin, scratch;
+
+           public:
+            std::vector<T> x;
+
+            prime_dft(int p_, const T e, bool rader_)
+                : p{p_}, rader{rader_ && has_minus<T>::value}
+            {
+                Wp = root_powers(e, p, p);
+                x.resize(2 * p);
+                if (!rader)
+                    return;
+
+                const int L = p - 1, g = primitive_root(p);
+                const int g_inv = detail::power_mod(g, p - 2, p);
+                gpow.resize(L);
+                ginv.resize(L);
+                for (int r = 0, u = 1, v = 1; r < L; ++r)
+                {
+                    gpow[r] = u;
+                    ginv[r] = v;
+                    u = 1LL * u * g % p;
+                    v = 1LL * v * g_inv % p;
+                }
+                for (int m = 0; m < L; ++m)
+                    c.push_back(Wp[ginv[m]]);
+                a.resize(L);
+                lin.resize(2 * L);
+                scratch.resize(8 * L + 16);
+            }
+
+            int size() const { return p; }
+
+            void operator()()
+            {
+                if constexpr (has_minus<T>::value)
+                    if (rader)
+                        return convolve();
+
+                for (int q = 0; q < p; ++q)
+                {
+                    const T& epq = Wp[q];
+                    T y = x[p - 1];
+                    for (int k = p - 2; k >= 0; --k)
+                        y = y * epq + x[k];
+                    x[p + q] = y;
+                }
+            }
+
+           private:
+            void convolve()
+            {
+                const int L = p - 1;
+                const T x0 = x[0];
+                T s = x0;
+                for (int k = 1; k < p; ++k)
+                    s += x[k];
+
+                for (int r = 0; r < L; ++r)
+                    a[r] = x[gpow[r]];
+                karatsuba(a.data(), c.data(), L, lin.data(), scratch.data());
+
+                // cyclic convolution: fold the linear one modulo x^L - 1
+                x[p] = s;
+                x[p + ginv[L - 1]] = x0 + lin[L - 1];
+                for (int q = 0; q < L - 1; ++q)
+                    x[p + ginv[q]] = x0 + lin[q] + lin[q + L];
+            }
+        };
+
+        /*
+            the kernels of the radices of P that have no codelet,
+            W[k] = e^k
+        */
+        template <class T>
+        std::vector<prime_dft<T>> prime_kernels(const std::vector<int>& P,
+                                                const std::vector<T>& W)
+        {
+            const int n = W.size();
+            std::vector<prime_dft<T>> K;
+            for (auto p : P)
+            {
+                if (p <= 7 || std::any_of(K.begin(), K.end(), [p](auto& k) {
+                        return k.size() == p;
+                    }))
+                    continue;
+                K.emplace_back(p, W[n / p], p > rader_threshold);
+            }
+            return K;
+        }
+
+        /*
+            Same as radix_stage_fixed, for a radix p that has no codelet.
+        */
+        template <class iter1, class iter2, class T>
+        void radix_stage_generic(iter1 in,
+                                 iter2 out,
+                                 const int n,
+                                 const int len_old,
+                                 const std::vector<T>& W,
+                                 prime_dft<T>& kernel)
+        {
+            const int p = kernel.size();
+            const int len = len_old * p, s = n / len;
+            auto& x = kernel.x;
+            for (int i = 0; i < n; i += len)
+            {
+                iter1 a = in + i;
+                iter2 b = out + i;
+                for (int r = 0; r < len_old; ++r)
+                {
+                    x[0] = a[r];
+                    for (int k = 1; k < p; ++k)
+                        x[k] = T(a[k * len_old + r]) * W[s * r * k];
+                    kernel();
+                    for (int q = 0; q < p; ++q)
+                        b[q * len_old + r] = x[p + q];
+                }
+            }
+        }
+
+        /*
+            One stage of the mixed-radix algorithm, dispatched to the
+            codelets of primitives.hpp when there is one for p, or to the
+            kernel of size p in K.
+        */
+        template <class iter1, class iter2, class T>
+        void mixed_radix_stage(iter1 in,
+                               iter2 out,
+                               const int n,
+                               const int len_old,
+                               const int p,
+                               const std::vector<T>& W,
+                               std::vector<prime_dft<T>>& K)
+        {
+            switch (p)
+            {
+                case 2:
+                    return radix_stage_fixed<2>(in, out, n, len_old, W);
+                case 3:
+                    return radix_stage_fixed<3>(in, out, n, len_old, W);
+                case 4:
+                    return radix_stage_fixed<4>(in, out, n, len_old, W);
+                case 5:
+                    return radix_stage_fixed<5>(in, out, n, len_old, W);
+                case 6:
+                    return radix_stage_fixed<6>(in, out, n, len_old, W);
+                case 7:
+                    return radix_stage_fixed<7>(in, out, n, len_old, W);
+                default:
+                    for (auto& k : K)
+                        if (k.size() == p)
+                            return radix_stage_generic(in, out, n, len_old, W,
+                                                       k);
+            }
+        }
+
+        /*
+            Twiddles of the mixed-radix stages on split data, stored by
+            stage so that radix_stage_split reads them contiguously: the
+            stage that merges the sub-transforms of length m with the radix
+            p reads
+            tw[m - 1 + (k-1)*m + r] = w^(r*k), 0 < k < p, r < m
+            with w = e^(n/(p*m)) and W[k] = e^k. The stages fill n-1 values.
+        */
+        template <class R>
+        std::pair<std::vector<R>, std::vector<R>> mixed_radix_twiddles_split(
+            const std::vector<std::complex<R>>& W,
+            const std::vector<int>& P)
+        {
+            const int n = W.size();
+            std::pair<std::vector<R>, std::vector<R>> tw;
+            tw.first.reserve(n - 1);
+            tw.second.reserve(n - 1);
+            int m = 1;
+            for (auto p : P)
+            {
+                const int s = n / (m * p);
+                for (int k = 1; k < p; ++k)
+                    for (int r = 0; r < m; ++r)
+                    {
+                        tw.first.push_back(W[s * r * k].real());
+                        tw.second.push_back(W[s * r * k].imag());
+                    }
+                m *= p;
+            }
+            return tw;
+        }
+
+        /*
+            DFT of size p = 2, 3, 4, 5 or 7 of the split values x + iy, in
+            place, where c[m] + is[m] = e_p^m: the codelets with real
+            operations only.
+        */
+        template <std::size_t p, class R>
+        void split_butterfly(std::array<R, p>& x,
+                             std::array<R, p>& y,
+                             const std::array<R, p>& c,
+                             const std::array<R, p>& s)
+        {
+            if constexpr (p == 2)
+            {
+                const R ar = x[0], ai = y[0];
+                x[0] = ar + x[1];
+                y[0] = ai + y[1];
+                x[1] = ar - x[1];
+                y[1] = ai - y[1];
+            }
+            else if constexpr (p == 4)
+            {
+                // e_p = +-i, the product by e_p swaps the parts
+                const R ar = x[0] + x[2], ai = y[0] + y[2];
+                const R br = x[0] - x[2], bi = y[0] - y[2];
+                const R cr = x[1] + x[3], ci = y[1] + y[3];
+                const R dr = s[1] * (y[3] - y[1]), di = s[1] * (x[1] - x[3]);
+                x[0] = ar + cr;
+                y[0] = ai + ci;
+                x[1] = br + dr;
+                y[1] = bi + di;
+                x[2] = ar - cr;
+                y[2] = ai - ci;
+                x[3] = br - dr;
+                y[3] = bi - di;
+            }
+            else
+            {
+                // same as FFT_odd_complex_fixed
+                constexpr std::size_t h = (p - 1) / 2;
+                std::array<R, h + 1> tr, ti, dr, di;
+                unroll<h>([&](auto k) {
+                    tr[k + 1] = x[k + 1] + x[p - 1 - k];
+                    ti[k + 1] = y[k + 1] + y[p - 1 - k];
+                    dr[k + 1] = x[k + 1] - x[p - 1 - k];
+                    di[k + 1] = y[k + 1] - y[p - 1 - k];
+                });
+                const R x0 = x[0], y0 = y[0];
+                unroll<h>([&](auto k) {
+                    x[0] += tr[k + 1];
+                    y[0] += ti[k + 1];
+                });
+                unroll<h>([&](auto q) {
+                    R ar = x0, ai = y0, br{}, bi{};
+                    unroll<h>([&](auto k) {
+                        constexpr std::size_t m = (q + 1) * (k + 1) % p;
+                        ar += c[m] * tr[k + 1];
+                        ai += c[m] * ti[k + 1];
+                        br += s[m] * dr[k + 1];
+                        bi += s[m] * di[k + 1];
+                    });
+                    x[q + 1] = ar - bi;
+                    y[q + 1] = ai + br;
+                    x[p - 1 - q] = ar + bi;
+                    y[p - 1 - q] = ai - br;
+                });
+            }
+        }
+
+        /*
+            Same as radix_stage_fixed on split data, the real parts in
+            in_re, out_re and the imaginary parts in in_im, out_im, with the
+            twiddles of the stage in tw_re, tw_im (see
+            mixed_radix_twiddles_split). The buffers do not overlap: the loop
+            over r is vectorized, and the loop over the blocks for the first
+            stage, len_old = 1.
+        */
+        template <std::size_t p, class R>
+        void radix_stage_split(const R* __restrict in_re,
+                               const R* __restrict in_im,
+                               R* __restrict out_re,
+                               R* __restrict out_im,
+                               const int n,
+                               const int len_old,
+                               const R* __restrict tw_re,
+                               const R* __restrict tw_im,
+                               const std::vector<std::complex<R>>& W)
+        {
+            const int len = len_old * p;
+            std::array<R, p> c, s, x, y;
+            for (std::size_t m = 0; m < p; ++m)
+            {
+                c[m] = W[m * (n / p)].real();
+                s[m] = W[m * (n / p)].imag();
+            }
+
+            if (len_old == 1)
+            {
+                for (int i = 0; i < n; i += p)
+                {
+                    unroll<p>([&](auto k) {
+                        x[k] = in_re[i + k];
+                        y[k] = in_im[i + k];
+                    });
+                    split_butterfly<p>(x, y, c, s);
+                    unroll<p>([&](auto q) {
+                        out_re[i + q] = x[q];
+                        out_im[i + q] = y[q];
+                    });
+                }
+                return;
+            }
+
+            for (int i = 0; i < n; i += len)
+                for (int r = 0; r < len_old; ++r)
+                {
+                    x[0] = in_re[i + r];
+                    y[0] = in_im[i + r];
+                    unroll<p - 1>([&](auto j) {
+                        const int a = i + (j + 1) * len_old + r;
+                        const R wr = tw_re[j * len_old + r];
+                        const R wi = tw_im[j * len_old + r];
+                        x[j + 1] = in_re[a] * wr - in_im[a] * wi;
+                        y[j + 1] = in_re[a] * wi + in_im[a] * wr;
+                    });
+                    split_butterfly<p>(x, y, c, s);
+                    unroll<p>([&](auto q) {
+                        out_re[i + q * len_old + r] = x[q];
+                        out_im[i + q * len_old + r] = y[q];
+                    });
+                }
+        }
+
+        /*
+            mixed_radix_stage on split data, with the twiddles of
+            mixed_radix_twiddles_split. The radices without a split codelet
+            run mixed_radix_stage through split_iterator.
+        */
+        template <class R>
+        void mixed_radix_stage_split(const R* in_re,
+                                     const R* in_im,
+                                     R* out_re,
+                                     R* out_im,
+                                     const int n,
+                                     const int len_old,
+                                     const int p,
+                                     const std::vector<R>& tw_re,
+                                     const std::vector<R>& tw_im,
+                                     const std::vector<std::complex<R>>& W,
+                                     std::vector<prime_dft<std::complex<R>>>& K)
+        {
+            const R* wr = tw_re.data() + len_old - 1;
+            const R* wi = tw_im.data() + len_old - 1;
+            switch (p)
+            {
+                case 2:
+                    return radix_stage_split<2>(in_re, in_im, out_re, out_im,
+                                                n, len_old, wr, wi, W);
+                case 3:
+                    return radix_stage_split<3>(in_re, in_im, out_re, out_im,
+                                                n, len_old, wr, wi, W);
+                case 4:
+                    return radix_stage_split<4>(in_re, in_im, out_re, out_im,
+                                                n, len_old, wr, wi, W);
+                case 5:
+                    return radix_stage_split<5>(in_re, in_im, out_re, out_im,
+                                                n, len_old, wr, wi, W);
+                case 7:
+                    return radix_stage_split<7>(in_re, in_im, out_re, out_im,
+                                                n, len_old, wr, wi, W);
+                default:
+                    return mixed_radix_stage(
+                        split_iterator<const R*>(in_re, in_im),
+                        split_iterator<R*>(out_re, out_im), n, len_old, p, W,
+                        K);
+            }
+        }
+    }  // namespace detail
+
+    /*
+        Rader's algorithm, the FT of prime size n as a cyclic convolution
+        of size n-1. It works for any ring T with a subtraction.
+        !!! n must be prime and e must be and n-root of unity (of the
+        identity)
+    */
+    template <class iter, class T>
+    void FFT_Rader(iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        if (n == 1)
+            return;
+        if (prime_factor(n) != n)
+            throw fftx::error(std::string(__func__) + " n=" +
+                              std::to_string(n) + " must be prime");
+
+        detail::prime_dft<T> kernel(n, e, true);
+        std::copy(first, last, kernel.x.begin());
+        kernel();
+        std::copy(kernel.x.begin() + n, kernel.x.end(), first);
+    }
+
     /*
         Divide and Conquer algorithm to compute the Discrete Fourier Transform:
         aka Fast Fourier Transform.
-        In a for loop
+        In a for loop, every stage is made of radix-p butterflies computed
+        by the codelets of primitives.hpp.
     */
     template <class T>
     std::vector<T> FFT_Iterative(const std::vector<T>& A, const T e)
@@ -108,46 +1401,32 @@ namespace fftx
         const int n = A.size();
         if (n == 1)
             return A;
-        const T _1 = power(e, n);
+        if constexpr (detail::is_complex<T>::value)
+        {
+            if (detail::use_bluestein<T>(n))
+                return FFT_Bluestein(A, e);
+        }
+
         std::vector<T> B(n), B_old(n);
-        auto P = prime_factorization(n);
+        auto P = detail::radices(n);
+        const auto W = root_powers(e, n, n);
 
         /* reorder input  */
+        const auto perm = detail::digit_reversal(n, P);
         for (int i = 0; i < n; ++i)
-        {
-            int j = 0, k = i;
-            for (auto p : P)
-            {
-                j = j * p + k % p;
-                k /= p;
-            }
-            B[j] = A[i];
-        }
+            B[perm[i]] = A[i];
 
         std::reverse(P.begin(), P.end());
 
         /* fft */
+        auto K = detail::prime_kernels(P, W);
         int len = 1;
         for (auto p : P)
         {
-            int len_old = len;
-            len *= p;
             std::swap(B, B_old);
-            T e2 = power(e, n / len);
-
-            for (int i = 0; i < n; i += len)
-            {
-                T ej = _1;
-                for (int j = 0; j < len; ++j, ej *= e2)
-                {
-                    T b{0};
-                    for (int k = p - 1; k >= 0; --k)
-                    {
-                        b = b * ej + B_old[i + k * len_old + j % len_old];
-                    }
-                    B[i + j] = b;
-                }
-            }
+            detail::mixed_radix_stage(B_old.begin(), B.begin(), n, len, p, W,
+                                      K);
+            len *= p;
         }
 
         return B;
@@ -163,6 +1442,11 @@ namespace fftx
         const int n = A.size();
         if (n == 1)
             return A;
+        if constexpr (detail::is_complex<T>::value)
+        {
+            if (detail::use_bluestein<T>(n))
+                return FFT_Bluestein(A, e);
+        }
 
         const T _1 = power(e, n);
         const int p = prime_factor(n);
@@ -195,6 +1479,82 @@ namespace fftx
         return B;
     }
 
+    namespace detail
+    {
+        /*
+            FFT_DivideAndConquer as a task of the scheduler s: the p
+            sub-transforms are spawned as tasks down to the size grain, and
+            the recombination is split into tasks of grain outputs, the
+            first power e^k of each one is computed with a fast power.
+        */
+        template <class T>
+        std::vector<T> divide_and_conquer_task(const std::vector<T>& A,
+                                               const T e,
+                                               task_scheduler& s,
+                                               const int grain)
+        {
+            const int n = A.size();
+            if (n <= grain || use_bluestein<T>(n))
+                return FFT_DivideAndConquer(A, e);
+
+            const int p = prime_factor(n);
+            const int m = n / p;
+            const auto ep = power(e, p);
+
+            std::vector<std::vector<T>> A_sub(p, std::vector<T>(m));
+            {
+                task_group g(s);
+                for (int i = 0; i < p; ++i)
+                    g.spawn([&, i] {
+                        for (int j = 0; j < m; ++j)
+                            A_sub[i][j] = A[j * p + i];
+                        A_sub[i] = divide_and_conquer_task(A_sub[i], ep, s,
+                                                           grain);
+                    });
+            }
+
+            std::vector<T> B(n);
+            {
+                task_group g(s);
+                for (int k_first = 0; k_first < n; k_first += grain)
+                    g.spawn([&, k_first] {
+                        const int k_last = std::min(n, k_first + grain);
+                        T ek = power(e, k_first ? k_first : n);
+                        for (int k = k_first; k < k_last; ++k, ek *= e)
+                        {
+                            T b{0};
+                            for (int i = p - 1; i >= 0; --i)
+                                b = b * ek + A_sub[i][k % m];
+                            B[k] = b;
+                        }
+                    });
+            }
+            return B;
+        }
+    }  // namespace detail
+
+    /*
+        Divide and Conquer algorithm with an execution policy, see
+        execution.hpp. With a parallel policy the recursion runs on the
+        work-stealing scheduler of scheduler.hpp: every sub-transform is a
+        task, which an idle thread can steal, down to the size grain.
+    */
+    template <class policy, class T>
+    typename std::enable_if<execution::is_execution_policy<policy>::value,
+                            std::vector<T>>::type
+    FFT_DivideAndConquer(const policy& pol, const std::vector<T>& A, const T e)
+    {
+        constexpr int grain = 1 << 12;
+        const int threads = detail::num_threads(pol);
+        if (threads <= 1 || int(A.size()) < parallel_threshold)
+            return FFT_DivideAndConquer(A, e);
+
+        auto& s = detail::task_scheduler::instance(threads);
+        std::vector<T> B;
+        s.run([&] { B = detail::divide_and_conquer_task(A, e, s, grain); });
+        return B;
+    }
+
     /*
         Divide and Conquer algorithm to compute the Discrete Fourier Transform:
         aka Fast Fourier Transform.
@@ -210,4 +1570,60 @@ namespace fftx
         return B;
     }
 
+    /*
+        Stockham autosort FFT.
+        !!! n must be a power of 2 and e must be and n-root of unity (_1)
+
+        Wrapper
+    */
+    template <class T>
+    std::vector<T> FFT_Stockham(const std::vector<T>& A, const T e)
+    {
+        std::vector<T> B(A);
+        FFT_Stockham(B.begin(), B.end(), e);
+        return B;
+    }
+
+    /*
+        Radix-4 FFT.
+        !!! n must be a power of 2 and e must be and n-root of unity (_1)
+
+        Wrapper
+    */
+    template <class T>
+    std::vector<T> FFT_Radix4(const std::vector<T>& A, const T e)
+    {
+        std::vector<T> B(A);
+        FFT_Radix4(B.begin(), B.end(), e);
+        return B;
+    }
+
+    /*
+        Split-radix FFT.
+        !!! n must be a power of 2 and e must be and n-root of unity (_1)
+
+        Wrapper
+    */
+    template <class T>
+    std::vector<T> FFT_SplitRadix(const std::vector<T>& A, const T e)
+    {
+        std::vector<T> B(A);
+        FFT_SplitRadix(B.begin(), B.end(), e);
+        return B;
+    }
+
+    /*
+        Rader's algorithm.
+        !!! n must be prime
+
+        Wrapper
+    */
+    template <class T>
+    std::vector<T> FFT_Rader(const std::vector<T>& A, const T e)
+    {
+        std::vector<T> B(A);
+        FFT_Rader(B.begin(), B.end(), e);
+        return B;
+    }
+
 }  // namespace fftx
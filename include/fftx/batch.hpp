@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fftx/exception.hpp>
+#include <fftx/plan.hpp>
+#include <fftx/primitives.hpp>
+#include <fftx/simd.hpp>
+
+/*
+    Batches of independent complex transforms of the same size n.
+
+    The layout follows the advanced interface of FFTW: transform b of the
+    batch (b < count) is made of the elements
+    first[b * distance + i * stride], i=0..n-1
+    eg. stride=1, distance=n for consecutive transforms, or stride=count,
+    distance=1 for interleaved ones.
+
+    The transforms are processed L at a time: the blocks are gathered in
+    complex_lanes, whose lane l holds the element of transform l, and the
+    usual engines run on complex_lanes. Every operation of the engine is
+    then an operation on L independent transforms, which the compiler maps
+    to the vector registers, so small sizes use the whole vector width.
+*/
+
+namespace fftx
+{
+    namespace detail
+    {
+        /*
+            L complex numbers with the real and imaginary parts in separate
+            arrays. The arithmetic is lane-wise; a complex number converts
+            to the L lanes that hold its value.
+        */
+        template <class R, int L>
+        struct complex_lanes
+        {
+            static constexpr int size = L;
+            std::array<R, L> re{}, im{};
+
+            complex_lanes() = default;
+            explicit complex_lanes(const R x) { re.fill(x); }
+            complex_lanes(const std::complex<R> z)
+            {
+                re.fill(z.real());
+                im.fill(z.imag());
+            }
+
+            complex_lanes& operator+=(const complex_lanes& b)
+            {
+                for (int l = 0; l < L; ++l)
+                {
+                    re[l] += b.re[l];
+                    im[l] += b.im[l];
+                }
+                return *this;
+            }
+            complex_lanes& operator-=(const complex_lanes& b)
+            {
+                for (int l = 0; l < L; ++l)
+                {
+                    re[l] -= b.re[l];
+                    im[l] -= b.im[l];
+                }
+                return *this;
+            }
+            complex_lanes& operator*=(const complex_lanes& b)
+            {
+                for (int l = 0; l < L; ++l)
+                {
+                    const R r = re[l] * b.re[l] - im[l] * b.im[l];
+                    im[l] = re[l] * b.im[l] + im[l] * b.re[l];
+                    re[l] = r;
+                }
+                return *this;
+            }
+
+            friend complex_lanes operator+(complex_lanes a,
+                                           const complex_lanes& b)
+            {
+                return a += b;
+            }
+            friend complex_lanes operator-(complex_lanes a,
+                                           const complex_lanes& b)
+            {
+                return a -= b;
+            }
+            friend complex_lanes operator*(complex_lanes a,
+                                           const complex_lanes& b)
+            {
+                return a *= b;
+            }
+        };
+
+        /*
+            number of transforms of a batch block: two vector registers of
+            R hold the real and imaginary parts of one complex_lanes
+        */
+        template <class R>
+        constexpr int batch_width = 2 * simd_pack<std::complex<R>>::size;
+
+        /*
+            x[i] lane l = first[(b + l) * distance + i * stride], l < L
+            the lanes after the end of the batch are 0, the offsets are
+            long long since count * distance may exceed an int
+        */
+        template <class iter, class V>
+        void batch_gather(iter first,
+                          V* x,
+                          int n,
+                          int b,
+                          int count,
+                          int stride,
+                          int distance)
+        {
+            const int lanes = std::min(V::size, count - b);
+            if (lanes < V::size)
+                std::fill(x, x + n, V{});
+            for (int l = 0; l < lanes; ++l)
+            {
+                iter src = first + (b + l) * (long long)distance;
+                for (int i = 0; i < n; ++i)
+                {
+                    const auto z = src[i * (long long)stride];
+                    x[i].re[l] = z.real();
+                    x[i].im[l] = z.imag();
+                }
+            }
+        }
+
+        template <class iter, class V>
+        void batch_scatter(const V* x,
+                           iter first,
+                           int n,
+                           int b,
+                           int count,
+                           int stride,
+                           int distance)
+        {
+            using C = typename std::iterator_traits<iter>::value_type;
+            const int lanes = std::min(V::size, count - b);
+            for (int l = 0; l < lanes; ++l)
+            {
+                iter dst = first + (b + l) * (long long)distance;
+                for (int i = 0; i < n; ++i)
+                    dst[i * (long long)stride] = C(x[i].re[l], x[i].im[l]);
+            }
+        }
+
+        /*
+            the fixed-size kernel of primitives.hpp for size n
+        */
+        template <std::size_t n, class iter, class T>
+        void fixed_kernel(iter first, const T e)
+        {
+            FFT_fixed<n>(first, first, e);
+        }
+
+        inline void check_batch(const char* func,
+                                int n,
+                                int count,
+                                int stride,
+                                int distance)
+        {
+            if (n < 1 || count < 0 || stride < 1 || distance < 0)
+                throw fftx::error(std::string(func) + " n=" +
+                                  std::to_string(n) + " count=" +
+                                  std::to_string(count) + " stride=" +
+                                  std::to_string(stride) + " distance=" +
+                                  std::to_string(distance) + " are invalid");
+        }
+    }  // namespace detail
+
+    /*
+        Precomputed batch of count transforms of size n, see above for the
+        layout. It runs a plan on complex_lanes, the tables and the
+        scratch buffer are allocated by the constructor only.
+        The forward transform uses e, the inverse e^(n-1), neither of them is
+        normalized.
+    */
+    template <class R>
+    class batch_plan
+    {
+        static constexpr int L = detail::batch_width<R>;
+        using V = detail::complex_lanes<R, L>;
+
+        int n, count, stride, distance;
+        plan<V> p;
+        std::vector<V> x;
+
+        template <class iter>
+        void execute(iter first, bool inv)
+        {
+            for (int b = 0; b < count; b += L)
+            {
+                detail::batch_gather(first, x.data(), n, b, count, stride,
+                                     distance);
+                if (inv)
+                    p.inverse(x.begin(), x.end());
+                else
+                    p.forward(x.begin(), x.end());
+                detail::batch_scatter(x.data(), first, n, b, count, stride,
+                                      distance);
+            }
+        }
+
+       public:
+        batch_plan(int n_,
+                   int count_,
+                   int stride_,
+                   int distance_,
+                   const std::complex<R> e)
+            : n{n_},
+              count{count_},
+              stride{stride_},
+              distance{distance_},
+              p(n_, V(e)),
+              x(n_)
+        {
+            detail::check_batch("batch_plan", n, count, stride, distance);
+        }
+
+        int size() const { return n; }
+
+        template <class iter>
+        void forward(iter first)
+        {
+            execute(first, false);
+        }
+
+        template <class iter>
+        void inverse(iter first)
+        {
+            execute(first, true);
+        }
+    };
+
+    /*
+        In-place transforms of a batch of count sequences of size n.
+    */
+    template <class iter, class R>
+    void FFT_Batch(iter first,
+                   int n,
+                   int count,
+                   int stride,
+                   int distance,
+                   const std::complex<R> e)
+    {
+        batch_plan<R>(n, count, stride, distance, e).forward(first);
+    }
+
+    /*
+        In-place transforms of a batch of count sequences of the fixed size
+        n, with the kernel FFT_fixed<n> of primitives.hpp applied to L
+        transforms at a time. The L transforms are kept on the stack, so
+        n is bounded by fixed_limit, larger sizes are for batch_plan.
+    */
+    template <std::size_t n, class iter, class R>
+    void FFT_Batch_fixed(iter first,
+                         int count,
+                         int stride,
+                         int distance,
+                         const std::complex<R> e)
+    {
+        constexpr int L = detail::batch_width<R>;
+        using V = detail::complex_lanes<R, L>;
+        static_assert(n <= fixed_limit,
+                      "FFT_Batch_fixed expects n <= fixed_limit");
+
+        detail::check_batch(__func__, n, count, stride, distance);
+        const V ev(e);
+        std::array<V, n> x;
+        for (int b = 0; b < count; b += L)
+        {
+            detail::batch_gather(first, x.data(), n, b, count, stride,
+                                 distance);
+            detail::fixed_kernel<n>(x.begin(), ev);
+            detail::batch_scatter(x.data(), first, n, b, count, stride,
+                                  distance);
+        }
+    }
+}  // namespace fftx
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+    Execution policies of the FFT engines, in the spirit of std::execution:
+    fftx::execution::seq runs on the calling thread,
+    fftx::execution::par splits the butterfly passes across the threads of
+    a persistent pool. parallel_policy{k} asks for k threads, the default
+    par uses all the hardware threads.
+
+    Transforms smaller than parallel_threshold always run serially, their
+    passes are too short to pay for the synchronization of the threads.
+*/
+
+namespace fftx
+{
+    namespace execution
+    {
+        struct sequenced_policy
+        {
+        };
+
+        struct parallel_policy
+        {
+            int threads = 0;  // 0: std::thread::hardware_concurrency()
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+
+        template <class P>
+        struct is_execution_policy
+            : std::integral_constant<
+                  bool,
+                  std::is_same<std::decay_t<P>, sequenced_policy>::value ||
+                      std::is_same<std::decay_t<P>, parallel_policy>::value>
+        {
+        };
+    }  // namespace execution
+
+    constexpr int parallel_threshold = 1 << 14;
+
+    namespace detail
+    {
+        /*
+            Persistent pool of worker threads. run(chunks, f) calls f(c) for
+            every c < chunks on the workers and on the calling thread, and
+            returns when all of them are done. The threads are created once
+            and sleep between two runs. The runs of several threads are
+            serialized and f must not start a run itself.
+        */
+        class thread_pool
+        {
+            std::vector<std::thread> workers;
+            std::mutex mtx, run_mtx;
+            std::condition_variable wake, done;
+            const std::function<void(int)>* job = nullptr;
+            int chunks = 0, pending = 0;  // chunks of the run not done yet
+            int active = 0;               // workers inside the run
+            std::atomic<int> next{0};
+            unsigned generation = 0;
+            bool stop = false;
+
+            // take chunks until none is left
+            void work(const std::function<void(int)>& f, int count)
+            {
+                int finished = 0;
+                for (int c; (c = next.fetch_add(1)) < count; ++finished)
+                    f(c);
+                std::lock_guard<std::mutex> lock(mtx);
+                pending -= finished;
+            }
+
+            void loop()
+            {
+                unsigned seen = 0;
+                for (;;)
+                {
+                    const std::function<void(int)>* f;
+                    int count;
+                    {
+                        std::unique_lock<std::mutex> lock(mtx);
+                        wake.wait(lock,
+                                  [&] { return stop || generation != seen; });
+                        if (stop)
+                            return;
+                        seen = generation;
+                        // a run that is already over must not be joined,
+                        // its job may not exist anymore
+                        if (pending == 0)
+                            continue;
+                        ++active;
+                        f = job;
+                        count = chunks;
+                    }
+                    work(*f, count);
+
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if (--active == 0 && pending == 0)
+                        done.notify_all();
+                }
+            }
+
+           public:
+            explicit thread_pool(int threads = 1) { resize(threads); }
+
+            ~thread_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    stop = true;
+                }
+                wake.notify_all();
+                for (auto& t : workers)
+                    t.join();
+            }
+
+            // the calling thread is one of the threads
+            int size() const { return workers.size() + 1; }
+
+            // grows the pool to at least the given number of threads
+            void resize(int threads)
+            {
+                std::lock_guard<std::mutex> lock(run_mtx);
+                while (size() < threads)
+                    workers.emplace_back([this] { loop(); });
+            }
+
+            void run(int count, const std::function<void(int)>& f)
+            {
+                std::lock_guard<std::mutex> guard(run_mtx);
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    job = &f;
+                    chunks = count;
+                    pending = count;
+                    next = 0;
+                    ++generation;
+                }
+                wake.notify_all();
+                work(f, count);
+
+                std::unique_lock<std::mutex> lock(mtx);
+                done.wait(lock, [&] { return pending == 0 && active == 0; });
+            }
+
+            static thread_pool& global()
+            {
+                static thread_pool pool(std::thread::hardware_concurrency());
+                return pool;
+            }
+        };
+
+        inline int num_threads(const execution::sequenced_policy&)
+        {
+            return 1;
+        }
+
+        inline int num_threads(const execution::parallel_policy& policy)
+        {
+            // hardware_concurrency() may cost a system call
+            static const int hw = std::thread::hardware_concurrency();
+            return policy.threads > 0 ? policy.threads : std::max(1, hw);
+        }
+
+        /*
+            f(begin, end) on a partition of [0, count) into contiguous
+            ranges, one per thread of the policy, at most count / grain of
+            them.
+        */
+        template <class policy, class F>
+        void parallel_for(const policy& pol, int count, int grain, F&& f)
+        {
+            const int threads =
+                std::min(num_threads(pol), count / std::max(1, grain));
+            if (threads <= 1)
+                return f(0, count);
+
+            auto& pool = thread_pool::global();
+            pool.resize(threads);
+            const std::function<void(int)> chunk = [&](int c) {
+                f(int((long long)count * c / threads),
+                  int((long long)count * (c + 1) / threads));
+            };
+            pool.run(threads, chunk);
+        }
+    }  // namespace detail
+}  // namespace fftx
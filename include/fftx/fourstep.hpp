@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <iterator>
+#include <vector>
+
+#include <fftx/math.hpp>
+#include <fftx/permutation.hpp>
+#include <fftx/plan.hpp>
+
+/*
+    Four-step and six-step FFT (Bailey) for the transforms larger than the
+    caches.
+
+    The input of size n = n1 n2 is seen as a matrix x[j1][j2] = x[j1 n2 + j2]
+    of n1 rows and n2 columns, with k = k1 + n1 k2:
+    X_k = sum_j2 e^(n1 j2 k2) [e^(j2 k1) sum_j1 x[j1][j2] e^(n2 j1 k1)]
+    ie. n2 FTs of size n1 on the columns, a multiplication by the twiddle
+    factors e^(j2 k1), n1 FTs of size n2 on the rows and a transposition.
+
+    The sub-transforms of size about sqrt(n) fit in the cache, and the data
+    goes through the main memory a fixed number of times instead of
+    log(n) times:
+    - four-step: the columns are transformed by blocks of
+      four_step_block columns, copied to a contiguous buffer, so that
+      every row of the matrix is read in runs of four_step_block elements.
+    - six-step: the columns become rows with a transposition before and
+      after their FTs, and all the FTs run on contiguous rows.
+    The transpositions are blocked in tiles of transpose_tile^2 elements.
+*/
+
+namespace fftx
+{
+    constexpr int four_step_block = 16;
+
+    namespace detail
+    {
+        /*
+            the largest divisor of n not above sqrt(n)
+        */
+        inline int four_step_split(long long n)
+        {
+            int n1 = 1;
+            for (int d = 1; (long long)d * d <= n; ++d)
+                if (n % d == 0)
+                    n1 = d;
+            return n1;
+        }
+
+        /*
+            Twiddle factors of the four-step FFT of size n = n1 n2, from
+            the tables
+            lo[b] = e^b, b < n2, and hi[a] = e^(a n2), a < n1
+            so that every twiddle e^m = hi[m / n2] lo[m % n2] costs a
+            product. n may not fit in an int.
+        */
+        template <class T>
+        class four_step_twiddles
+        {
+            int n1 = 1, n2 = 1;
+            std::vector<T> lo, hi;
+
+           public:
+            four_step_twiddles() = default;
+            four_step_twiddles(int n1_, int n2_, const T e)
+                : n1{n1_}, n2{n2_}
+            {
+                if constexpr (is_complex<T>::value)
+                {
+                    // e^m = exp(i m arg(e)) without the round-off of the
+                    // powers
+                    using R = typename T::value_type;
+                    const R theta = std::arg(e);
+                    for (long long m = 0; m < n2; ++m)
+                        lo.push_back(std::polar(R(1), theta * m));
+                    for (long long m = 0; m < (long long)n1 * n2; m += n2)
+                        hi.push_back(std::polar(R(1), theta * m));
+                }
+                else
+                {
+                    // exact arithmetic, the recurrence does not drift
+                    hi = root_powers(power(e, n2), n1, n1);
+                    lo.push_back(hi[0]);
+                    for (int b = 1; b < n2; ++b)
+                        lo.push_back(lo.back() * e);
+                }
+            }
+
+            /*
+                x[k] *= e^(j k), or e^(-j k) for the inverse, k = 1..n1-1,
+                j < n2. The exponent m = a n2 + b is walked by steps of j,
+                without divisions.
+            */
+            template <class iter>
+            void apply(iter x, int j, bool inv) const
+            {
+                for (int k = 1, a = 0, b = 0; k < n1; ++k)
+                {
+                    if (!inv && (b += j) >= n2)
+                    {
+                        b -= n2;
+                        ++a;
+                    }
+                    if (inv && (b -= j) < 0)
+                    {
+                        b += n2;
+                        if (--a < 0)
+                            a += n1;
+                    }
+                    x[k] *= hi[a] * lo[b];
+                }
+            }
+        };
+    }  // namespace detail
+
+    /*
+        Precomputed four-step or six-step FFT of size n = n1 n2, where n1 is
+        the largest divisor of n not above sqrt(n). It is made of two plans
+        of sizes n1 and n2 and of the twiddle tables of about sqrt(n)
+        elements. The prime sizes (n1 = 1) are given to a single plan.
+
+        As for plan, the inverse uses e^(n-1) and is not normalized, the
+        memory is allocated by the constructor only and the same
+        four_step_plan must not be executed by two threads at the same time.
+    */
+    template <class T>
+    class four_step_plan
+    {
+        int n, n1, n2;
+        bool six_step;
+        plan<T> cols, rows;  // sizes n1 and n2
+        detail::four_step_twiddles<T> twiddles;
+        std::vector<T> work;
+
+        template <class iter>
+        void four_steps(iter first, bool inv)
+        {
+            constexpr int b = four_step_block;
+            // the FTs of the columns j2..j2+w-1, in work[c n1 + j1]
+            for (int j2 = 0; j2 < n2; j2 += b)
+            {
+                const int w = std::min(b, n2 - j2);
+                for (int j1 = 0; j1 < n1; ++j1)
+                    for (int c = 0; c < w; ++c)
+                        work[c * n1 + j1] = first[(long long)j1 * n2 + j2 + c];
+                for (int c = 0; c < w; ++c)
+                {
+                    auto col = work.begin() + c * n1;
+                    inv ? cols.inverse(col, col + n1)
+                        : cols.forward(col, col + n1);
+                    twiddles.apply(col, j2 + c, inv);
+                }
+                for (int k1 = 0; k1 < n1; ++k1)
+                    for (int c = 0; c < w; ++c)
+                        first[(long long)k1 * n2 + j2 + c] = work[c * n1 + k1];
+            }
+            transform_rows(first, inv);
+        }
+
+        template <class iter>
+        void six_steps(iter first, bool inv)
+        {
+            detail::transpose(first, work.begin(), n1, n2);
+            for (int j2 = 0; j2 < n2; ++j2)
+            {
+                auto row = work.begin() + (long long)j2 * n1;
+                inv ? cols.inverse(row, row + n1) : cols.forward(row, row + n1);
+                twiddles.apply(row, j2, inv);
+            }
+            detail::transpose(work.begin(), first, n2, n1);
+            transform_rows(first, inv);
+        }
+
+        // the FTs of the rows, then X[k1 + n1 k2] = x[k1][k2]
+        template <class iter>
+        void transform_rows(iter first, bool inv)
+        {
+            for (int k1 = 0; k1 < n1; ++k1)
+            {
+                iter row = first + (long long)k1 * n2;
+                inv ? rows.inverse(row, row + n2) : rows.forward(row, row + n2);
+            }
+            detail::transpose(first, work.begin(), n1, n2);
+            std::copy(work.begin(), work.end(), first);
+        }
+
+        template <class iter>
+        void execute(iter first, iter last [[maybe_unused]], bool inv)
+        {
+            if (n1 == 1)
+                return inv ? rows.inverse(first, last)
+                           : rows.forward(first, last);
+            if (six_step)
+                six_steps(first, inv);
+            else
+                four_steps(first, inv);
+        }
+
+       public:
+        four_step_plan(int n_, const T e, bool six_step_ = false)
+            : n{n_},
+              n1{n_ > 0 ? detail::four_step_split(n_) : 1},
+              n2{n_ / n1},
+              six_step{six_step_},
+              cols(n1, power(e, n2)),
+              rows(n2, power(e, n1))
+        {
+            if (n1 == 1)
+                return;
+            twiddles = detail::four_step_twiddles<T>(n1, n2, e);
+            work.resize(n);
+        }
+
+        int size() const { return n; }
+
+        template <class iter>
+        void forward(iter first, iter last)
+        {
+            execute(first, last, false);
+        }
+
+        template <class iter>
+        void inverse(iter first, iter last)
+        {
+            execute(first, last, true);
+        }
+    };
+
+    /*
+        Four-step FFT of [first, last), for any size n.
+    */
+    template <class iter, class T>
+    void FFT_FourStep(iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        four_step_plan<T>(n, e).forward(first, last);
+    }
+
+    /*
+        Six-step FFT of [first, last), for any size n.
+    */
+    template <class iter, class T>
+    void FFT_SixStep(iter first, iter last, const T e)
+    {
+        const int n = std::distance(first, last);
+        four_step_plan<T>(n, e, true).forward(first, last);
+    }
+
+    /*
+        Four-step FFT.
+
+        Wrapper
+    */
+    template <class T>
+    std::vector<T> FFT_FourStep(const std::vector<T>& A, const T e)
+    {
+        std::vector<T> B(A);
+        FFT_FourStep(B.begin(), B.end(), e);
+        return B;
+    }
+
+    /*
+        Six-step FFT.
+
+        Wrapper
+    */
+    template <class T>
+    std::vector<T> FFT_SixStep(const std::vector<T>& A, const T e)
+    {
+        std::vector<T> B(A);
+        FFT_SixStep(B.begin(), B.end(), e);
+        return B;
+    }
+}  // namespace fftx
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <fftx/exception.hpp>
@@ -36,6 +40,33 @@ namespace fftx
         return r;
     }
 
+    /*
+        Table of powers e^k, k=0..m-1, where e is an n-root of unity.
+        The first 64 powers are computed by recurrence, the others as
+        e^(b+r) = e^b e^r with a fast power e^b every 64 steps, so that the
+        round-off of the floating point types does not accumulate along the
+        table and the products do not depend on each other.
+    */
+    template <class T>
+    std::vector<T> root_powers(const T e, int n, int m)
+    {
+        constexpr int B = 64;
+        std::vector<T> W;
+        W.reserve(m);
+        if (m > 0)
+            W.push_back(power(e, n));
+        for (int k = 1; k < std::min(m, B); ++k)
+            W.push_back(W.back() * e);
+        // e^(b+r) = e^b e^r, the products are independent
+        for (int b = B; b < m; b += B)
+        {
+            const T eb = power(e, b);
+            for (int r = 0; r < B && b + r < m; ++r)
+                W.push_back(eb * W[r]);
+        }
+        return W;
+    }
+
     /*
         Least prime factor of n
         O(sqrt(n))
@@ -74,4 +105,138 @@ namespace fftx
         return F;
     }
 
+    namespace detail
+    {
+        /* x^k mod m */
+        inline long long power_mod(long long x, long long k, long long m)
+        {
+            long long r = 1 % m;
+            for (x %= m; k; k >>= 1)
+            {
+                if (k & 1)
+                    r = r * x % m;
+                x = x * x % m;
+            }
+            return r;
+        }
+    }  // namespace detail
+
+    /*
+        Least primitive root modulo the prime p, ie. the generator of the
+        multiplicative group of the integers modulo p.
+    */
+    inline int primitive_root(int p)
+    {
+        if (p == 2)
+            return 1;
+        const auto F = prime_factorization(p - 1);
+        for (int g = 2;; ++g)
+        {
+            bool generator = true;
+            for (auto q : F)
+                if (detail::power_mod(g, (p - 1) / q, p) == 1)
+                {
+                    generator = false;
+                    break;
+                }
+            if (generator)
+                return g;
+        }
+    }
+
+    namespace detail
+    {
+        template <class T, class = void>
+        struct has_minus : std::false_type
+        {
+        };
+
+        template <class T>
+        struct has_minus<
+            T,
+            std::void_t<decltype(std::declval<T>() - std::declval<T>())>>
+            : std::true_type
+        {
+        };
+
+        template <class T>
+        struct is_complex : std::false_type
+        {
+        };
+
+        template <class R>
+        struct is_complex<std::complex<R>> : std::true_type
+        {
+        };
+
+        /*
+            type of the real and imaginary parts of the complex T, of the
+            split complex storage, T itself for the other types
+        */
+        template <class T>
+        struct real_part
+        {
+            typedef T type;
+        };
+
+        template <class R>
+        struct real_part<std::complex<R>>
+        {
+            typedef R type;
+        };
+
+        /*
+            a - b
+            types without a subtraction compute a + f * b instead, where f
+            is the square root of the identity that is not the identity, ie.
+            e^(n/2) for an n-root of unity e with n even
+        */
+        template <class T>
+        T minus(const T& a, const T& b, const T& f [[maybe_unused]])
+        {
+            if constexpr (has_minus<T>::value)
+                return T(a - b);
+            else
+                return a + b * f;
+        }
+
+        /*
+            Twiddle factors of the power of two engines, stored by stage so
+            that every butterfly loop reads them contiguously:
+            tw[h + j] = e^(j n/2h), j < h, for h = 1, 2, 4 .. n/2
+            and tw[0] = e^(n/2).
+        */
+        template <class T>
+        std::vector<T> stage_twiddles(const T e, const int n)
+        {
+            if (n == 1)
+                return {e};
+
+            // tw[n/2 + j] = e^j, then tw[h + j] = tw[2h + 2j]
+            auto tw = root_powers(e, n, n / 2);
+            tw.resize(n, e);
+            std::copy(tw.begin(), tw.begin() + n / 2, tw.begin() + n / 2);
+            tw[0] = power(e, n / 2);
+            for (int h = n / 4; h > 0; h >>= 1)
+                for (int j = 0; j < h; ++j)
+                    tw[h + j] = tw[2 * h + 2 * j];
+            return tw;
+        }
+
+        /*
+            j * x where j is a 4-root of unity (of the identity)
+            for the complex numbers j = +-i and the product is a swap of the
+            real and imaginary parts
+        */
+        template <class T>
+        T mul_j(const T& j, const T& x)
+        {
+            if constexpr (is_complex<T>::value)
+                return j.imag() > 0 ? T(-x.imag(), x.real())
+                                    : T(x.imag(), -x.real());
+            else
+                return j * x;
+        }
+    }  // namespace detail
+
 }  // namespace fftx
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fftx/exception.hpp>
+
+/*
+    Integers modulo an odd prime p, for the number-theoretic transforms.
+
+    modular<U, p> stores x R mod p (Montgomery form), R = 2^32 for the 32-bit
+    U and 2^64 for the 64-bit U, and multiplies without divisions:
+    a b / R = (a b - m p) / R, with m = a b p^-1 mod R
+    the division by R being a shift, ie. the high half of the double width
+    products. p < R/4 leaves two bits free in U, so that the engines can
+    delay the reductions (Harvey): the butterflies of ntt.hpp keep their
+    values in [0, 4p) and only reduce them below p at the end of the
+    transform.
+*/
+
+namespace fftx
+{
+    namespace detail
+    {
+        template <class U>
+        struct wide_integer;
+
+        template <>
+        struct wide_integer<std::uint32_t>
+        {
+            typedef std::uint64_t type;
+        };
+
+        template <>
+        struct wide_integer<std::uint64_t>
+        {
+            __extension__ typedef unsigned __int128 type;
+        };
+    }  // namespace detail
+
+    template <class U, U p>
+    class modular
+    {
+        static_assert(std::is_same<U, std::uint32_t>::value ||
+                          std::is_same<U, std::uint64_t>::value,
+                      "modular stores std::uint32_t or std::uint64_t");
+        static_assert(p % 2 == 1 && p < (U(1) << (8 * sizeof(U) - 2)),
+                      "modular expects an odd p < 2^30 (or 2^62)");
+
+        using W = typename detail::wide_integer<U>::type;
+        static constexpr int bits = 8 * sizeof(U);
+
+        // p^-1 mod R by Newton's iteration, p p = 1 mod 8 is exact on 3 bits
+        static constexpr U inverse_p()
+        {
+            U x = p;
+            for (int i = 0; i < 5; ++i)
+                x *= U(2) - p * x;
+            return x;
+        }
+        static constexpr U r1 = U(U(0) - p) % p;     // R mod p
+        static constexpr U r2 = U(W(r1) * r1 % p);  // R^2 mod p
+
+        U x = 0;
+
+        static U reduce(U a) { return a >= p ? a - p : a; }
+
+       public:
+        typedef U integer;
+        static constexpr U modulus = p;
+        static constexpr U p_inv = inverse_p();  // p^-1 mod R
+        static_assert(U(p * p_inv) == 1);
+
+        /*
+            the Montgomery representation and its inverse, for the engines
+            whose values are not reduced below p
+        */
+        U raw() const { return x; }
+        static modular from_raw(U a)
+        {
+            modular r;
+            r.x = a;
+            return r;
+        }
+
+        /*
+            a b / R mod p in [0, 2p), for a b < p R, eg. a < 4p and b < p
+            or a < R and b < p
+        */
+        static U mul_lazy(U a, U b)
+        {
+            const W t = W(a) * b;
+            const U m = U(t) * p_inv;
+            return U(t >> bits) - U((W(m) * p) >> bits) + p;
+        }
+
+        constexpr modular() = default;
+
+        // a mod p, without division if |a| < R
+        template <class I,
+                  class = typename std::enable_if<
+                      std::is_integral<I>::value>::type>
+        modular(I a)
+        {
+            const bool negative = a < I(0);
+            // |a|, also for the most negative a
+            std::uint64_t v = negative ? std::uint64_t(-(a + 1)) + 1
+                                       : std::uint64_t(a);
+            if (v > U(-1))
+                v %= p;
+            x = reduce(mul_lazy(U(v), r2));
+            if (negative && x)
+                x = p - x;
+        }
+
+        // the integer in [0, p)
+        U value() const { return reduce(mul_lazy(x, 1)); }
+        explicit operator U() const { return value(); }
+
+        modular& operator+=(const modular& b)
+        {
+            x = reduce(x + b.x);
+            return *this;
+        }
+        modular& operator-=(const modular& b)
+        {
+            x = x >= b.x ? x - b.x : x + p - b.x;
+            return *this;
+        }
+        modular& operator*=(const modular& b)
+        {
+            x = reduce(mul_lazy(x, b.x));
+            return *this;
+        }
+        modular& operator/=(const modular& b) { return *this *= b.inverse(); }
+
+        friend modular operator+(modular a, const modular& b) { return a += b; }
+        friend modular operator-(modular a, const modular& b) { return a -= b; }
+        friend modular operator*(modular a, const modular& b) { return a *= b; }
+        friend modular operator/(modular a, const modular& b) { return a /= b; }
+        modular operator-() const { return modular{} - *this; }
+
+        friend bool operator==(const modular& a, const modular& b)
+        {
+            return a.x == b.x;
+        }
+        friend bool operator!=(const modular& a, const modular& b)
+        {
+            return a.x != b.x;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const modular& a)
+        {
+            return os << a.value() << " (mod " << p << ")";
+        }
+
+        modular pow(std::uint64_t k) const
+        {
+            modular r{1}, a{*this};
+            for (; k; k >>= 1)
+            {
+                if (k & 1)
+                    r *= a;
+                a *= a;
+            }
+            return r;
+        }
+
+        modular inverse() const { return pow(p - 2); }
+
+        /*
+            Least generator of the multiplicative group, computed once
+        */
+        static modular generator()
+        {
+            static const modular g = [] {
+                std::vector<U> F;
+                U m = p - 1;
+                for (U q = 2; q <= m / q; ++q)
+                    if (m % q == 0)
+                    {
+                        F.push_back(q);
+                        while (m % q == 0)
+                            m /= q;
+                    }
+                if (m > 1)
+                    F.push_back(m);
+                for (U g = 2;; ++g)
+                {
+                    bool generator = true;
+                    for (auto q : F)
+                        if (modular(g).pow((p - 1) / q) == modular(1))
+                        {
+                            generator = false;
+                            break;
+                        }
+                    if (generator)
+                        return modular(g);
+                }
+            }();
+            return g;
+        }
+
+        /*
+            a primitive n-root of unity, n must divide p - 1
+        */
+        static modular root_of_unity(std::uint64_t n)
+        {
+            if (n == 0 || (p - 1) % n)
+                throw fftx::error("modular: no " + std::to_string(n) +
+                                  "-root of unity modulo " +
+                                  std::to_string(p));
+            return generator().pow((p - 1) / n);
+        }
+    };
+
+    template <std::uint32_t p>
+    using mod32 = modular<std::uint32_t, p>;
+
+    template <std::uint64_t p>
+    using mod64 = modular<std::uint64_t, p>;
+
+    namespace detail
+    {
+        template <class T>
+        struct is_modular : std::false_type
+        {
+        };
+
+        template <class U, U p>
+        struct is_modular<modular<U, p>> : std::true_type
+        {
+        };
+    }  // namespace detail
+}  // namespace fftx
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include <fftx/exception.hpp>
+#include <fftx/plan.hpp>
+
+/*
+    Distributed 3D FFT of a N0 x N1 x N2 row-major volume over the ranks of
+    an MPI communicator, with a pencil decomposition. This header needs
+    MPI and is not included by fftx.hpp.
+
+    The ranks form a P0 x P1 grid, rank = p0 P1 + p1. Every axis is
+    transformed when it is local and contiguous, between the passes the
+    ranks of a row (same p0) or of a column (same p1) of the grid exchange
+    their blocks with MPI_Alltoallv:
+    1. input [i0][i1][i2], i0 in block(N0, P0, p0), i1 in block(N1, P1, p1):
+       FTs along i2
+    2. exchange in the row: [i0][k2][i1], k2 in block(N2, P1, p1):
+       FTs along i1
+    3. exchange in the column: [k2][k1][i0], k1 in block(N1, P0, p0):
+       FTs along i0
+    where block(N, P, p) = [N p / P, N (p+1) / P). The output is left in
+    the transposed order [k2][k1][k0], the inverse takes it back to the
+    order of the input.
+*/
+
+namespace fftx
+{
+    /*
+        seconds spent by a pencil_plan in the transforms along every axis
+        and in the exchanges that make the axis local, since the last
+        reset
+    */
+    struct pencil_timings
+    {
+        std::array<double, 3> compute{}, communicate{};
+    };
+
+    namespace detail
+    {
+        inline int block_start(int N, int P, int p)
+        {
+            return (long long)N * p / P;
+        }
+
+        inline int block_size(int N, int P, int p)
+        {
+            return block_start(N, P, p + 1) - block_start(N, P, p);
+        }
+
+        /*
+            All-to-all transposition in comm of an array with the axes
+            a (A values), g (gathered: block(Ng, Q, rank) in the input, all
+            of them in the output) and s (split: all Ns of them in the
+            input, block(Ns, Q, rank) in the output). The strides of a, g, s
+            in the input and the output are given in elements.
+        */
+        template <class T>
+        void pencil_exchange(MPI_Comm comm,
+                             const T* in,
+                             T* out,
+                             int A,
+                             int Ng,
+                             int Ns,
+                             const std::array<long long, 3>& si,
+                             const std::array<long long, 3>& so,
+                             std::vector<T>& send,
+                             std::vector<T>& recv)
+        {
+            int Q, me;
+            MPI_Comm_size(comm, &Q);
+            MPI_Comm_rank(comm, &me);
+            const int g_me = block_size(Ng, Q, me);
+            const int s_me = block_size(Ns, Q, me);
+
+            std::vector<int> sendcount(Q), recvcount(Q), sdispl(Q), rdispl(Q);
+            long long spos = 0, rpos = 0;
+            for (int q = 0; q < Q; ++q)
+            {
+                const long long sc =
+                    (long long)A * g_me * block_size(Ns, Q, q) * sizeof(T);
+                const long long rc =
+                    (long long)A * block_size(Ng, Q, q) * s_me * sizeof(T);
+                if (sc > INT_MAX || rc > INT_MAX || spos > INT_MAX ||
+                    rpos > INT_MAX)
+                    throw fftx::error("pencil_plan: the blocks exceed the "
+                                      "int counts of MPI");
+                sendcount[q] = sc;
+                recvcount[q] = rc;
+                sdispl[q] = spos;
+                rdispl[q] = rpos;
+                spos += sc;
+                rpos += rc;
+            }
+
+            // blocks in the order (a, g, s) for every rank
+            T* x = send.data();
+            for (int q = 0; q < Q; ++q)
+            {
+                const int s0 = block_start(Ns, Q, q);
+                const int s1 = block_start(Ns, Q, q + 1);
+                for (int a = 0; a < A; ++a)
+                    for (int g = 0; g < g_me; ++g)
+                    {
+                        const T* row = in + a * si[0] + g * si[1];
+                        for (int s = s0; s < s1; ++s)
+                            *x++ = row[s * si[2]];
+                    }
+            }
+
+            MPI_Alltoallv(send.data(), sendcount.data(), sdispl.data(),
+                          MPI_BYTE, recv.data(), recvcount.data(),
+                          rdispl.data(), MPI_BYTE, comm);
+
+            const T* y = recv.data();
+            for (int q = 0; q < Q; ++q)
+            {
+                const int g0 = block_start(Ng, Q, q);
+                const int g1 = block_start(Ng, Q, q + 1);
+                for (int a = 0; a < A; ++a)
+                    for (int g = g0; g < g1; ++g)
+                    {
+                        T* row = out + a * so[0] + g * so[1];
+                        for (int s = 0; s < s_me; ++s)
+                            row[s * so[2]] = *y++;
+                    }
+            }
+        }
+    }  // namespace detail
+
+    /*
+        Precomputed distributed 3D FFT, see above. roots[d] is the root of
+        unity of the axis d, of order shape[d]. The grid is P0 x P1, by
+        default the one of MPI_Dims_create. The plan splits comm, it must be
+        created, executed and destroyed by all the ranks of comm.
+
+        The forward transform uses the roots, the inverse their inverses,
+        neither of them is normalized.
+    */
+    template <class T>
+    class pencil_plan
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "pencil_plan sends the raw bytes of T");
+
+        std::array<int, 3> N;
+        int P0 = 0, P1 = 0, p0, p1;
+        MPI_Comm row, col;  // same p0, same p1
+        std::array<plan<T>, 3> plans;
+        std::vector<T> work, stage, send, recv;
+        pencil_timings times;
+
+        // n0 x n1 x N2 input, N0 x m1 x m2 output
+        int n0, n1, m1, m2;
+
+        void transform(int d, T* x, long long count, bool inv)
+        {
+            const double t = MPI_Wtime();
+            for (long long r = 0; r < count; ++r)
+            {
+                T* first = x + r * N[d];
+                inv ? plans[d].inverse(first, first + N[d])
+                    : plans[d].forward(first, first + N[d]);
+            }
+            times.compute[d] += MPI_Wtime() - t;
+        }
+
+        template <class... Args>
+        void exchange(int d, Args&&... args)
+        {
+            const double t = MPI_Wtime();
+            detail::pencil_exchange(std::forward<Args>(args)..., send, recv);
+            times.communicate[d] += MPI_Wtime() - t;
+        }
+
+       public:
+        pencil_plan(MPI_Comm comm,
+                    const std::array<int, 3>& shape,
+                    const std::array<T, 3>& roots,
+                    int P0_ = 0,
+                    int P1_ = 0)
+            : N{shape},
+              P0{P0_},
+              P1{P1_},
+              plans{plan<T>(shape[0], roots[0]), plan<T>(shape[1], roots[1]),
+                    plan<T>(shape[2], roots[2])}
+        {
+            int size, rank;
+            MPI_Comm_size(comm, &size);
+            MPI_Comm_rank(comm, &rank);
+            // checked before MPI_Dims_create, whose errors abort the job
+            const bool valid =
+                P0 >= 0 && P1 >= 0 &&
+                (P0 && P1 ? (long long)P0 * P1 == size
+                          : (!P0 || size % P0 == 0) && (!P1 || size % P1 == 0));
+            int dims[2] = {P0, P1};
+            if (!valid || MPI_Dims_create(size, 2, dims) != MPI_SUCCESS)
+                throw fftx::error("pencil_plan: invalid grid " +
+                                  std::to_string(P0) + " x " +
+                                  std::to_string(P1) + " for " +
+                                  std::to_string(size) + " ranks");
+            P0 = dims[0];
+            P1 = dims[1];
+            p0 = rank / P1;
+            p1 = rank % P1;
+            MPI_Comm_split(comm, p0, p1, &row);
+            MPI_Comm_split(comm, p1, p0, &col);
+
+            n0 = detail::block_size(N[0], P0, p0);
+            n1 = detail::block_size(N[1], P1, p1);
+            m2 = detail::block_size(N[2], P1, p1);
+            m1 = detail::block_size(N[1], P0, p0);
+            const long long len =
+                std::max({(long long)n0 * n1 * N[2], (long long)n0 * m2 * N[1],
+                          (long long)m2 * m1 * N[0]});
+            work.resize(len);
+            stage.resize(len);
+            send.resize(len);
+            recv.resize(len);
+        }
+
+        ~pencil_plan()
+        {
+            MPI_Comm_free(&row);
+            MPI_Comm_free(&col);
+        }
+
+        pencil_plan(const pencil_plan&) = delete;
+        pencil_plan& operator=(const pencil_plan&) = delete;
+
+        std::array<int, 2> grid() const { return {P0, P1}; }
+
+        /*
+            the block of the rank in the input, of the global
+            [start[0], start[0]+size[0]) x ... in the order i0, i1, i2
+        */
+        std::array<int, 3> input_start() const
+        {
+            return {detail::block_start(N[0], P0, p0),
+                    detail::block_start(N[1], P1, p1), 0};
+        }
+        std::array<int, 3> input_size() const { return {n0, n1, N[2]}; }
+
+        /*
+            the block of the rank in the output, in the order k2, k1, k0
+        */
+        std::array<int, 3> output_start() const
+        {
+            return {detail::block_start(N[2], P1, p1),
+                    detail::block_start(N[1], P0, p0), 0};
+        }
+        std::array<int, 3> output_size() const { return {m2, m1, N[0]}; }
+
+        const pencil_timings& timings() const { return times; }
+        void reset_timings() { times = {}; }
+
+        /*
+            in: the input block of the rank, out: its output block, they
+            may be the same array if it holds both. The data is
+            exchanged with all the ranks of the row and of the column.
+        */
+        void forward(const T* in, T* out)
+        {
+            std::copy(in, in + (long long)n0 * n1 * N[2], work.begin());
+            transform(2, work.data(), (long long)n0 * n1, false);
+            // [i0][i1][i2] -> [i0][k2][i1]
+            exchange(1, row, work.data(), stage.data(), n0, N[1], N[2],
+                     std::array<long long, 3>{(long long)n1 * N[2], N[2], 1},
+                     std::array<long long, 3>{(long long)m2 * N[1], 1, N[1]});
+            transform(1, stage.data(), (long long)n0 * m2, false);
+            // [i0][k2][k1] -> [k2][k1][i0]
+            exchange(0, col, stage.data(), work.data(), m2, N[0], N[1],
+                     std::array<long long, 3>{N[1], (long long)m2 * N[1], 1},
+                     std::array<long long, 3>{(long long)m1 * N[0], 1, N[0]});
+            transform(0, work.data(), (long long)m2 * m1, false);
+            std::copy(work.begin(), work.begin() + (long long)m2 * m1 * N[0],
+                      out);
+        }
+
+        /*
+            in: the output block of the rank, out: its input block
+        */
+        void inverse(const T* in, T* out)
+        {
+            std::copy(in, in + (long long)m2 * m1 * N[0], work.begin());
+            transform(0, work.data(), (long long)m2 * m1, true);
+            // [k2][k1][i0] -> [i0][k2][k1]
+            exchange(0, col, work.data(), stage.data(), m2, N[1], N[0],
+                     std::array<long long, 3>{(long long)m1 * N[0], N[0], 1},
+                     std::array<long long, 3>{N[1], 1, (long long)m2 * N[1]});
+            transform(1, stage.data(), (long long)n0 * m2, true);
+            // [i0][k2][i1] -> [i0][i1][i2]
+            exchange(1, row, stage.data(), work.data(), n0, N[2], N[1],
+                     std::array<long long, 3>{(long long)m2 * N[1], N[1], 1},
+                     std::array<long long, 3>{(long long)n1 * N[2], 1, N[2]});
+            transform(2, work.data(), (long long)n0 * n1, true);
+            std::copy(work.begin(), work.begin() + (long long)n0 * n1 * N[2],
+                      out);
+        }
+    };
+}  // namespace fftx
@@ -1,43 +1,533 @@
 #pragma once
 
-#include <fftx/1d.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fftx/exception.hpp>
+#include <fftx/execution.hpp>
+#include <fftx/permutation.hpp>
+#include <fftx/plan.hpp>
+
+/*
+    Multidimensional FFT of N^dim values in row-major order.
+
+    Every pass transforms the contiguous rows of length N, ie. the last
+    axis, and transposes the data as a N^(dim-1) x N matrix, which moves
+    the last axis to the front:
+    (i_0, ..., i_dim-1) -> (i_dim-1, i_0, ..., i_dim-2)
+    After dim passes every axis was transformed and the axes are back in
+    their order. The transpositions are tiled (see permutation.hpp) and
+    go back and forth between the data and a single scratch buffer.
+
+    nd_plan transforms arrays of any shape and strides, eg. row-major,
+    column-major or a sub-block of a larger array, along a subset of their
+    axes. The lines of an axis are transformed in place through a
+    strided_iterator when they span less than strided_threshold elements,
+    otherwise nd_block neighbouring lines at a time are copied to a small
+    contiguous buffer, so that every cache line and page of the data is
+    used nd_block times. No full-size buffer is allocated.
+*/
 
 namespace fftx
 {
+    constexpr int nd_block = 16;
+    constexpr long long strided_threshold = 1 << 12;
+
+    /*
+        Random access iterator over base[0], base[stride], base[2 stride]...
+        The position is kept as an index, the iterators past the end do not
+        point outside of the data.
+    */
+    template <class iter>
+    class strided_iterator
+    {
+        iter base;
+        long long stride = 1, i = 0;
+
+       public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::iterator_traits<iter>::value_type;
+        using difference_type = long long;
+        using pointer = typename std::iterator_traits<iter>::pointer;
+        using reference = typename std::iterator_traits<iter>::reference;
+
+        strided_iterator() = default;
+        strided_iterator(iter base_, long long stride_, long long i_ = 0)
+            : base{base_}, stride{stride_}, i{i_}
+        {
+        }
+
+        reference operator*() const { return base[i * stride]; }
+        reference operator[](long long k) const
+        {
+            return base[(i + k) * stride];
+        }
+
+        strided_iterator& operator++()
+        {
+            ++i;
+            return *this;
+        }
+        strided_iterator& operator--()
+        {
+            --i;
+            return *this;
+        }
+        strided_iterator operator++(int) { return {base, stride, i++}; }
+        strided_iterator operator--(int) { return {base, stride, i--}; }
+        strided_iterator& operator+=(long long k)
+        {
+            i += k;
+            return *this;
+        }
+        strided_iterator& operator-=(long long k)
+        {
+            i -= k;
+            return *this;
+        }
+
+        friend strided_iterator operator+(strided_iterator a, long long k)
+        {
+            return a += k;
+        }
+        friend strided_iterator operator+(long long k, strided_iterator a)
+        {
+            return a += k;
+        }
+        friend strided_iterator operator-(strided_iterator a, long long k)
+        {
+            return a -= k;
+        }
+        friend long long operator-(const strided_iterator& a,
+                                   const strided_iterator& b)
+        {
+            return a.i - b.i;
+        }
+
+        friend bool operator==(const strided_iterator& a,
+                               const strided_iterator& b)
+        {
+            return a.i == b.i;
+        }
+        friend bool operator!=(const strided_iterator& a,
+                               const strided_iterator& b)
+        {
+            return a.i != b.i;
+        }
+        friend bool operator<(const strided_iterator& a,
+                              const strided_iterator& b)
+        {
+            return a.i < b.i;
+        }
+        friend bool operator>(const strided_iterator& a,
+                              const strided_iterator& b)
+        {
+            return a.i > b.i;
+        }
+        friend bool operator<=(const strided_iterator& a,
+                               const strided_iterator& b)
+        {
+            return a.i <= b.i;
+        }
+        friend bool operator>=(const strided_iterator& a,
+                               const strided_iterator& b)
+        {
+            return a.i >= b.i;
+        }
+    };
+
+    /*
+        strides of a contiguous array of the given shape, in elements
+    */
+    inline std::vector<long long> row_major_strides(
+        const std::vector<int>& shape)
+    {
+        std::vector<long long> strides(shape.size());
+        long long s = 1;
+        for (int d = shape.size() - 1; d >= 0; --d)
+        {
+            strides[d] = s;
+            s *= shape[d];
+        }
+        return strides;
+    }
+
+    inline std::vector<long long> column_major_strides(
+        const std::vector<int>& shape)
+    {
+        std::vector<long long> strides(shape.size());
+        long long s = 1;
+        for (std::size_t d = 0; d < shape.size(); ++d)
+        {
+            strides[d] = s;
+            s *= shape[d];
+        }
+        return strides;
+    }
+
+    namespace detail
+    {
+        /*
+            the axes of the loops over the array, without the skipped ones,
+            by decreasing stride
+        */
+        inline std::vector<int> loop_axes(const std::vector<long long>& strides,
+                                          const std::vector<bool>& skip)
+        {
+            std::vector<int> dims;
+            for (std::size_t d = 0; d < strides.size(); ++d)
+                if (!skip[d])
+                    dims.push_back(d);
+            std::sort(dims.begin(), dims.end(), [&](int a, int b) {
+                return std::llabs(strides[a]) > std::llabs(strides[b]);
+            });
+            return dims;
+        }
+
+        /*
+            f(offset) for every index of the axes dims of loop_axes, the
+            last one varies the fastest. idx holds at least dims.size()
+            indices.
+        */
+        template <class F>
+        void for_each_offset(const std::vector<int>& shape,
+                             const std::vector<long long>& strides,
+                             const std::vector<int>& dims,
+                             std::vector<int>& idx,
+                             F&& f)
+        {
+            std::fill(idx.begin(), idx.begin() + dims.size(), 0);
+            long long offset = 0;
+            for (;;)
+            {
+                f(offset);
+                int k = dims.size() - 1;
+                for (; k >= 0; --k)
+                {
+                    const int d = dims[k];
+                    offset += strides[d];
+                    if (++idx[k] < shape[d])
+                        break;
+                    offset -= strides[d] * shape[d];
+                    idx[k] = 0;
+                }
+                if (k < 0)
+                    return;
+            }
+        }
+
+        template <int dim>
+        void check_dim(long long n, int N)
+        {
+            static_assert(dim > 0, "FFT_dim expects at least one dimension");
+            long long len = 1;
+            for (int d = 0; d < dim; ++d)
+                len *= N;
+            if (N < 1 || n != len)
+                throw fftx::error("FFT_dim expects N^" + std::to_string(dim) +
+                                  " values, N=" + std::to_string(N) +
+                                  " n=" + std::to_string(n));
+        }
+
+        /*
+            Storage of n values split in parts, the part p being
+            [n p / parts, n (p+1) / parts). The values of every part are
+            constructed by the thread that runs it: on a NUMA machine the
+            operating system places a page in the node of the thread that
+            touches it first, so every thread then works in its local
+            memory.
+        */
+        template <class T>
+        class first_touch_buffer
+        {
+            std::allocator<T> alloc;
+            long long n;
+            T* x;
+
+           public:
+            template <class policy>
+            first_touch_buffer(const policy& pol, long long n_, int parts)
+                : n{n_}, x{alloc.allocate(n_)}
+            {
+                parallel_for(pol, parts, 1, [&](int p_first, int p_last) {
+                    std::uninitialized_default_construct(
+                        x + n * p_first / parts, x + n * p_last / parts);
+                });
+            }
+
+            ~first_touch_buffer()
+            {
+                std::destroy(x, x + n);
+                alloc.deallocate(x, n);
+            }
+
+            first_touch_buffer(const first_touch_buffer&) = delete;
+            first_touch_buffer& operator=(const first_touch_buffer&) = delete;
+
+            T* begin() const { return x; }
+        };
+    }  // namespace detail
+
     template <int dim, class iter, class T>
-    void FFT_dim(iter first,
-                 iter last,
-                 const int N,
-                 const T e,
-                 const T _1 = T(1))
+    void FFT_dim(iter first, iter last, const int N, const T e)
     {
-        size_t len = power(N, dim);
-        std::vector<T> buff(len);
+        const long long n = std::distance(first, last);
+        detail::check_dim<dim>(n, N);
 
-        std::copy(first, last, buff.begin());
+        plan<T> P(N, e);
+        std::vector<T> scratch(n);
+        const int rows = n / N;
+
+        auto transform_rows = [&](auto x) {
+            for (int r = 0; r < rows; ++r)
+                P.forward(x + (long long)r * N, x + (long long)(r + 1) * N);
+        };
 
         for (int d = 0; d < dim; ++d)
         {
-            // perform 1D fft
-            for (size_t i = 0; i < buff.size();)
+            if (d % 2 == 0)
+            {
+                transform_rows(first);
+                detail::transpose(first, scratch.begin(), rows, N);
+            }
+            else
             {
-                int j = i + N;
-                FFT_InPlace(&buff[i], &buff[j], e, _1);
-                i = j;
+                transform_rows(scratch.begin());
+                detail::transpose(scratch.begin(), first, rows, N);
             }
+        }
+        if (dim % 2)
+            std::copy(scratch.begin(), scratch.end(), first);
+    }
+
+    /*
+        With an execution policy, see execution.hpp. The lines of every
+        pass and the output rows of every transposition are split in
+        slabs, one per thread. The slab of the lines of a thread is the
+        slab of the transposition that it wrote, and the scratch buffer is
+        first touched by the same partition, so that on a NUMA machine the
+        thread works on local memory. The input is as local as its own
+        first touch.
+    */
+    template <int dim, class policy, class iter, class T>
+    typename std::enable_if<execution::is_execution_policy<policy>::value,
+                            void>::type
+    FFT_dim(const policy& pol, iter first, iter last, const int N, const T e)
+    {
+        const long long n = std::distance(first, last);
+        if (n < parallel_threshold)
+            return FFT_dim<dim>(first, last, N, e);
+        detail::check_dim<dim>(n, N);
 
-            const int pN = power(N, dim - 1);
-            // transpose
-            std::vector<T> tmp(len);
-            for (size_t i = 0, j; i < tmp.size(); ++i)
+        const int parts = std::min(detail::num_threads(pol), N);
+        const int rows = n / N;
+        std::vector<plan<T>> plans;  // one per thread, for its scratch
+        for (int p = 0; p < parts; ++p)
+            plans.emplace_back(N, e);
+        detail::first_touch_buffer<T> scratch(pol, n, parts);
+
+        // f(p) for every part p, in parallel
+        auto for_each_part = [&](auto&& f) {
+            detail::parallel_for(pol, parts, 1, [&](int p_first, int p_last) {
+                for (int p = p_first; p < p_last; ++p)
+                    f(p);
+            });
+        };
+        auto pass = [&](auto x, auto y) {
+            for_each_part([&](int p) {
+                const long long r_first = (long long)rows * p / parts;
+                const long long r_last = (long long)rows * (p + 1) / parts;
+                for (long long r = r_first; r < r_last; ++r)
+                    plans[p].forward(x + r * N, x + (r + 1) * N);
+            });
+            for_each_part([&](int p) {
+                detail::transpose(x, y, rows, N, N * p / parts,
+                                  N * (p + 1) / parts);
+            });
+        };
+
+        for (int d = 0; d < dim; ++d)
+        {
+            if (d % 2 == 0)
+                pass(first, scratch.begin());
+            else
+                pass(scratch.begin(), first);
+        }
+        if (dim % 2)
+            for_each_part([&](int p) {
+                std::copy(scratch.begin() + n * p / parts,
+                          scratch.begin() + n * (p + 1) / parts,
+                          first + n * p / parts);
+            });
+    }
+
+    /*
+        Precomputed transform of an array of the given shape and strides
+        (in elements, possibly negative) along the given axes. roots[i] is
+        the root of unity of the axis axes[i], of order shape[axes[i]].
+        The plans of the axes, the loops over the other axes and the block
+        buffer are allocated by the constructor only. The forward transform
+        uses the roots, the inverse their inverses, neither of them is
+        normalized.
+    */
+    template <class T>
+    class nd_plan
+    {
+        std::vector<int> shape;
+        std::vector<long long> strides;
+        std::vector<int> axes;
+        std::vector<plan<T>> plans;
+        std::vector<std::vector<int>> loops;  // loop_axes of every axis
+        std::vector<int> blocked;  // the axis u of the blocks, or -1
+        std::vector<int> idx;      // the indices of for_each_offset
+        std::vector<T> block;      // nd_block lines of the longest axis
+
+        template <class iter>
+        void transform(const int i, iter first, bool inv)
+        {
+            auto& P = plans[i];
+            const int a = axes[i], N = shape[a];
+            const long long s = strides[a];
+            const int u = blocked[i];
+            auto run = [&](auto x) {
+                inv ? P.inverse(x, x + N) : P.forward(x, x + N);
+            };
+
+            if (s == 1)
+                return detail::for_each_offset(
+                    shape, strides, loops[i], idx,
+                    [&](long long offset) { run(first + offset); });
+            if (u < 0)
+                return detail::for_each_offset(
+                    shape, strides, loops[i], idx, [&](long long offset) {
+                        run(strided_iterator<iter>(first + offset, s));
+                    });
+
+            // the lines offset + c, c < m, neighbours along the axis u
+            auto run_block = [&](long long offset) {
+                for (int c0 = 0; c0 < shape[u]; c0 += nd_block)
+                {
+                    const int m = std::min(nd_block, shape[u] - c0);
+                    iter x = first + offset + c0;
+                    for (int k = 0; k < N; ++k)
+                        for (int c = 0; c < m; ++c)
+                            block[c * N + k] = x[k * s + c];
+                    for (int c = 0; c < m; ++c)
+                        run(block.begin() + c * N);
+                    for (int k = 0; k < N; ++k)
+                        for (int c = 0; c < m; ++c)
+                            x[k * s + c] = block[c * N + k];
+                }
+            };
+            detail::for_each_offset(shape, strides, loops[i], idx,
+                                    run_block);
+        }
+
+        template <class iter>
+        void execute(iter first, bool inv)
+        {
+            for (std::size_t i = 0; i < axes.size(); ++i)
+                transform(i, first, inv);
+        }
+
+       public:
+        nd_plan(const std::vector<int>& shape_,
+                const std::vector<long long>& strides_,
+                const std::vector<int>& axes_,
+                const std::vector<T>& roots)
+            : shape{shape_}, strides{strides_}, axes{axes_}
+        {
+            const int dim = shape.size();
+            if (dim == 0 || int(strides.size()) != dim ||
+                axes.size() != roots.size())
+                throw fftx::error("nd_plan: " + std::to_string(dim) +
+                                  " dimensions, " +
+                                  std::to_string(strides.size()) +
+                                  " strides, " + std::to_string(axes.size()) +
+                                  " axes and " + std::to_string(roots.size()) +
+                                  " roots do not match");
+            std::vector<bool> seen(dim);
+            int longest = 0;
+            for (int a : axes)
+            {
+                if (a < 0 || a >= dim || seen[a])
+                    throw fftx::error("nd_plan: invalid axis " +
+                                      std::to_string(a));
+                seen[a] = true;
+                longest = std::max(longest, shape[a]);
+            }
+            for (int d = 0; d < dim; ++d)
+                if (shape[d] < 1)
+                    throw fftx::error("nd_plan: invalid shape " +
+                                      std::to_string(shape[d]));
+            for (std::size_t i = 0; i < axes.size(); ++i)
+                plans.emplace_back(shape[axes[i]], roots[i]);
+            block.resize((long long)nd_block * longest);
+
+            // the lines of an axis a are contiguous, strided, or in blocks
+            // along the contiguous axis u other than a
+            for (int a : axes)
             {
-                j = i / N + (i % N) * pN;
-                tmp[i] = buff[j];
+                int u = -1;
+                if (strides[a] != 1 &&
+                    std::llabs(strides[a]) * shape[a] > strided_threshold)
+                    for (int d = 0; d < dim; ++d)
+                        if (d != a && strides[d] == 1)
+                            u = d;
+                std::vector<bool> skip(dim);
+                skip[a] = true;
+                if (u >= 0)
+                    skip[u] = true;
+                loops.push_back(detail::loop_axes(strides, skip));
+                blocked.push_back(u);
             }
+            idx.resize(dim);
+        }
+
+        template <class iter>
+        void forward(iter first)
+        {
+            execute(first, false);
+        }
 
-            buff = std::move(tmp);
+        template <class iter>
+        void inverse(iter first)
+        {
+            execute(first, true);
         }
-        std::copy(buff.begin(), buff.end(), first);
+    };
+
+    /*
+        In-place transform of the array at first of the given shape and
+        strides along the given axes, see nd_plan.
+    */
+    template <class iter, class T>
+    void FFT_nd(iter first,
+                const std::vector<int>& shape,
+                const std::vector<long long>& strides,
+                const std::vector<int>& axes,
+                const std::vector<T>& roots)
+    {
+        nd_plan<T>(shape, strides, axes, roots).forward(first);
+    }
+
+    /*
+        In-place transform of the contiguous row-major array at first along
+        all its axes, roots[d] of order shape[d].
+    */
+    template <class iter, class T>
+    void FFT_nd(iter first,
+                const std::vector<int>& shape,
+                const std::vector<T>& roots)
+    {
+        std::vector<int> axes(shape.size());
+        std::iota(axes.begin(), axes.end(), 0);
+        FFT_nd(first, shape, row_major_strides(shape), axes, roots);
     }
 }  // namespace fftx
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fftx/exception.hpp>
+#include <fftx/execution.hpp>
+#include <fftx/math.hpp>
+#include <fftx/modular.hpp>
+#include <fftx/permutation.hpp>
+#include <fftx/simd.hpp>
+
+/*
+    Number-theoretic transforms of power of two sizes on the modular integers
+    of modular.hpp, eg. for the exact products of polynomials.
+
+    The radix-2 butterflies reduce lazily: u, v = u + w v, u - w v + 2p keep
+    the values below 4p, u being first reduced below 2p, and the last pass
+    reduces its outputs below p. The passes run by blocks of ntt_l1_block,
+    then ntt_l2_block elements, so that only the last log(n / ntt_l2_block)
+    passes go through the main memory. On 32-bit residues in contiguous
+    memory the butterflies are vectorized, see ntt_pack in simd.hpp.
+
+    integer_convolution computes the exact products of integer polynomials
+    with one NTT per prime of ntt_primes, as many primes as the bound of
+    the coefficients needs, and rebuilds the coefficients from their
+    residues with Garner's algorithm: in the mixed radix
+    c = t_0 + p_0 (t_1 + p_1 (t_2 + ...)), t_i < p_i
+    the digit t_i only needs arithmetic modulo p_i, then c is evaluated in
+    the result type, by a Horner scheme.
+*/
+
+namespace fftx
+{
+    constexpr int ntt_l1_block = 1 << 12;
+    constexpr int ntt_l2_block = 1 << 18;
+
+    namespace detail
+    {
+        /*
+            stage_twiddles(e, n) in Montgomery form, and w p^-1 mod R for
+            the vectorized products
+        */
+        template <class M>
+        struct ntt_twiddles
+        {
+            using U = typename M::integer;
+            std::vector<U> w, wq;
+
+            ntt_twiddles(const M e, const int n)
+            {
+                const auto t = stage_twiddles(e, n);
+                w.resize(t.size());
+                for (std::size_t k = 0; k < t.size(); ++k)
+                    w[k] = t[k].raw();
+                if constexpr (sizeof(U) == 4)
+                {
+                    wq.resize(w.size());
+                    for (std::size_t k = 0; k < w.size(); ++k)
+                        wq[k] = w[k] * M::p_inv;
+                }
+            }
+        };
+
+        /*
+            pass(i0, i1, h) for the radix-2 passes h, 2h .. n/2, on the
+            blocks [i0, i1) of the caches
+        */
+        template <class Pass>
+        void ntt_blocked_passes(const int n, int h, Pass&& pass)
+        {
+            for (int B : {ntt_l1_block, ntt_l2_block, n})
+            {
+                B = std::min(B, n);
+                for (int i = 0; h < B && i < n; i += B)
+                    for (int k = h; k < B; k <<= 1)
+                        pass(i, i + B, k);
+                h = std::max(h, B);
+            }
+        }
+
+        /*
+            pass(i0, i1, h) for the radix-2 passes n/2 .. 2h, h, in this
+            order, on the blocks [i0, i1) of the caches
+        */
+        template <class Pass>
+        void ntt_blocked_passes_dif(const int n, const int h, Pass&& pass)
+        {
+            const int B[] = {std::min(ntt_l1_block, n),
+                             std::min(ntt_l2_block, n), n};
+            for (int l = 2; l >= 0; --l)
+            {
+                const int h_last = l > 0 ? std::max(B[l - 1], h) : h;
+                for (int i = 0; i < n; i += B[l])
+                    for (int k = B[l] / 2; k >= h_last; k >>= 1)
+                        pass(i, i + B[l], k);
+            }
+        }
+
+        /*
+            Lazy radix-2 passes of the power of two NTT on the bit reversed
+            [first, first + n), the inputs are below 4p.
+        */
+        template <class iter, class M>
+        void ntt_dit(iter first, const int n, const ntt_twiddles<M>& tw)
+        {
+            using U = typename M::integer;
+            constexpr U p = M::modulus, p2 = 2 * p;
+            const U* w = tw.w.data();
+
+            if constexpr (std::is_same<U, std::uint32_t>::value &&
+                          (ntt_pack::size > 1) && is_contiguous<iter>::value)
+                if (n >= 2 * ntt_pack::size)
+                {
+                    // a modular is its representation
+                    static_assert(sizeof(M) == sizeof(U) &&
+                                  std::is_standard_layout<M>::value);
+                    U* x = reinterpret_cast<U*>(&*first);
+                    const U* wq = tw.wq.data();
+                    ntt_blocked_passes(
+                        n, ntt_pack::size, [&](int i0, int i1, int h) {
+                            if (h == ntt_pack::size)
+                                ntt_register_passes<false>(x + i0, i1 - i0,
+                                                           w, wq, p);
+                            for (int i = i0; i < i1; i += 2 * h)
+                                ntt_butterflies(x + i, x + i + h, w + h, wq + h,
+                                                h, p, 2 * h == n);
+                        });
+                    return;
+                }
+
+            ntt_blocked_passes(n, 1, [&](int i0, int i1, int h) {
+                const bool last = 2 * h == n;
+                for (int i = i0; i < i1; i += 2 * h)
+                    for (int j = 0; j < h; ++j)
+                    {
+                        U u = first[i + j].raw();
+                        u -= u >= p2 ? p2 : 0;
+                        const U v =
+                            M::mul_lazy(first[i + j + h].raw(), w[h + j]);
+                        U a = u + v, b = u - v + p2;
+                        if (last)
+                        {
+                            a -= a >= p2 ? p2 : 0;
+                            a -= a >= p ? p : 0;
+                            b -= b >= p2 ? p2 : 0;
+                            b -= b >= p ? p : 0;
+                        }
+                        first[i + j] = M::from_raw(a);
+                        first[i + j + h] = M::from_raw(b);
+                    }
+            });
+        }
+
+        /*
+            Lazy radix-2 passes of the power of two NTT (Gentleman-Sande) on
+            [first, first + n), the output is bit reversed. The inputs and
+            the outputs are below 2p.
+            u, v = u + v, w (u - v + 2p)
+        */
+        template <class iter, class M>
+        void ntt_dif(iter first, const int n, const ntt_twiddles<M>& tw)
+        {
+            using U = typename M::integer;
+            constexpr U p = M::modulus, p2 = 2 * p;
+            const U* w = tw.w.data();
+
+            if constexpr (std::is_same<U, std::uint32_t>::value &&
+                          (ntt_pack::size > 1) && is_contiguous<iter>::value)
+                if (n >= 2 * ntt_pack::size)
+                {
+                    static_assert(sizeof(M) == sizeof(U) &&
+                                  std::is_standard_layout<M>::value);
+                    U* x = reinterpret_cast<U*>(&*first);
+                    const U* wq = tw.wq.data();
+                    ntt_blocked_passes_dif(
+                        n, ntt_pack::size, [&](int i0, int i1, int h) {
+                            for (int i = i0; i < i1; i += 2 * h)
+                                ntt_butterflies_dif(x + i, x + i + h, w + h,
+                                                    wq + h, h, p);
+                            if (h == ntt_pack::size)
+                                ntt_register_passes<true>(x + i0, i1 - i0, w,
+                                                          wq, p);
+                        });
+                    return;
+                }
+
+            ntt_blocked_passes_dif(n, 1, [&](int i0, int i1, int h) {
+                for (int i = i0; i < i1; i += 2 * h)
+                    for (int j = 0; j < h; ++j)
+                    {
+                        const U u = first[i + j].raw();
+                        const U v = first[i + j + h].raw();
+                        const U a = u + v;
+                        first[i + j] = M::from_raw(a - (a >= p2 ? p2 : 0));
+                        first[i + j + h] =
+                            M::from_raw(M::mul_lazy(u - v + p2, w[h + j]));
+                    }
+            });
+        }
+    }  // namespace detail
+
+    /*
+        Precomputed NTT of size n, a power of 2 that divides p - 1. The
+        stage twiddles of e and of e^-1 are computed by the constructor, which
+        is the only place where memory is allocated or an exception is
+        thrown. By default e is a primitive n-root of unity modulo p.
+
+        The forward transform uses e, the inverse transform uses e^-1,
+        neither of them is normalized.
+    */
+    template <class M>
+    class ntt_plan
+    {
+        static_assert(detail::is_modular<M>::value,
+                      "ntt_plan expects a modular integer");
+
+        int n;
+        detail::ntt_twiddles<M> tw, tw_inv;
+
+        static int checked(int n)
+        {
+            if (n < 1 || __builtin_popcount(n) != 1)
+                throw fftx::error("ntt_plan: n=" + std::to_string(n) +
+                                  " must be a power of 2");
+            return n;
+        }
+
+       public:
+        ntt_plan(int n_, const M e)
+            : n{checked(n_)}, tw(e, n), tw_inv(e.inverse(), n)
+        {
+        }
+
+        explicit ntt_plan(int n_) : ntt_plan(n_, M::root_of_unity(checked(n_)))
+        {
+        }
+
+        int size() const { return n; }
+
+        template <class iter>
+        void forward(iter first, iter last)
+        {
+            bit_reverse_permutation(first, last);
+            detail::ntt_dit(first, n, tw);
+        }
+
+        template <class iter>
+        void inverse(iter first, iter last)
+        {
+            bit_reverse_permutation(first, last);
+            detail::ntt_dit(first, n, tw_inv);
+        }
+
+        /*
+            The forward transform, in the bit reversed order, with values
+            reduced below 2p only. The inverse of such a transform, or of a
+            product of them, takes it back to the natural order: the
+            convolutions need no permutation.
+        */
+        template <class iter>
+        void forward_bit_reversed(iter first, iter last [[maybe_unused]])
+        {
+            detail::ntt_dif(first, n, tw);
+        }
+
+        template <class iter>
+        void inverse_bit_reversed(iter first, iter last [[maybe_unused]])
+        {
+            detail::ntt_dit(first, n, tw_inv);
+        }
+    };
+
+    namespace detail
+    {
+        /*
+            The primes p < 2^30 such that 2^23 divides p - 1, the largest
+            first: 257 bits for the sizes up to 2^23.
+        */
+        constexpr std::uint32_t ntt_primes[] = {
+            998244353, 897581057, 880803841, 754974721, 645922817,
+            595591169, 469762049, 377487361, 167772161};
+        constexpr int ntt_primes_count = std::size(ntt_primes);
+        constexpr int ntt_primes_log = 23;
+
+        __extension__ typedef __int128 int128;
+        __extension__ typedef unsigned __int128 uint128;
+
+        /*
+            bits of the results of integer_convolution<R>, INT_MAX for the
+            arbitrary precision types
+        */
+        template <class R>
+        constexpr int result_digits()
+        {
+            if constexpr (std::is_same<R, int128>::value)
+                return 127;
+            else if constexpr (std::is_same<R, uint128>::value)
+                return 128;
+            else if constexpr (std::numeric_limits<R>::is_bounded)
+                return std::numeric_limits<R>::digits;
+            else
+                return INT_MAX;
+        }
+
+        /*
+            r = a b mod ntt_primes[i] by an NTT of size m, the n
+            coefficients of the product reduced below the prime
+        */
+        template <std::size_t i, class I>
+        void residue_product(const std::vector<I>& a,
+                             const std::vector<I>& b,
+                             const int m,
+                             std::uint32_t* r)
+        {
+            using M = mod32<ntt_primes[i]>;
+            const int n = a.size() + b.size() - 1;
+            std::vector<M> A(a.begin(), a.end()), B(b.begin(), b.end());
+            A.resize(m);
+            B.resize(m);
+            ntt_plan<M> P(m);
+            P.forward_bit_reversed(A.begin(), A.end());
+            P.forward_bit_reversed(B.begin(), B.end());
+            const M m_inv = M(m).inverse();
+            for (int k = 0; k < m; ++k)
+                A[k] *= B[k] * m_inv;
+            P.inverse_bit_reversed(A.begin(), A.end());
+            for (int k = 0; k < n; ++k)
+                r[k] = A[k].value();
+        }
+
+        /*
+            the digit i of the coefficients k0 <= k < k1, in place of their
+            residue modulo p_i in t[i]:
+            t_i = (r_i - (t_0 + p_0 (t_1 + ... p_(i-2) t_(i-1)))) / (p_0 ..
+            p_(i-1)) mod p_i
+        */
+        template <std::size_t i>
+        void garner_digit(std::uint32_t* const* t, const int k0, const int k1)
+        {
+            using M = mod32<ntt_primes[i]>;
+            std::array<M, i> c;  // p_j mod p_i
+            M inv{1};
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                c[j] = M(ntt_primes[j]);
+                inv *= c[j];
+            }
+            inv = inv.inverse();
+            for (int k = k0; k < k1; ++k)
+            {
+                M s{t[i - 1][k]};
+                for (int j = int(i) - 2; j >= 0; --j)
+                    s = s * c[j] + M(t[j][k]);
+                t[i][k] = ((M(t[i][k]) - s) * inv).value();
+            }
+        }
+
+        template <class I, std::size_t... i>
+        constexpr auto residue_table(std::index_sequence<i...>)
+        {
+            using kernel = void (*)(const std::vector<I>&,
+                                    const std::vector<I>&, int,
+                                    std::uint32_t*);
+            return std::array<kernel, sizeof...(i)>{
+                &residue_product<i, I>...};
+        }
+
+        template <std::size_t... i>
+        constexpr auto garner_table(std::index_sequence<i...>)
+        {
+            using kernel = void (*)(std::uint32_t* const*, int, int);
+            return std::array<kernel, sizeof...(i)>{&garner_digit<i + 1>...};
+        }
+
+        template <class I>
+        int bit_length(const std::vector<I>& a)
+        {
+            std::uint64_t bound = 0;
+            for (const I x : a)
+                bound |= x < I(0) ? std::uint64_t(-(x + 1)) + 1
+                                  : std::uint64_t(x);
+            return bound ? 64 - __builtin_clzll(bound) : 0;
+        }
+
+        /*
+            c = sum t_j (p_0 .. p_(j-1)), minus p_0 .. p_(K-1) if c is above
+            half of it, ie. if its digits are above the ones of
+            (p_0 .. p_(K-1) - 1) / 2, which are (p_j - 1) / 2. The builtin
+            types compute modulo 2^bits, with an unsigned type of the same
+            size.
+        */
+        template <class R>
+        R garner_value(std::uint32_t* const* t, const int K, const int k)
+        {
+            using A = typename std::conditional<
+                result_digits<R>() == INT_MAX,
+                R,
+                typename std::conditional<(result_digits<R>() > 64),
+                                          uint128,
+                                          std::uint64_t>::type>::type;
+            bool negative = false;
+            for (int j = K - 1; j >= 0; --j)
+                if (t[j][k] != (ntt_primes[j] - 1) / 2)
+                {
+                    negative = t[j][k] > (ntt_primes[j] - 1) / 2;
+                    break;
+                }
+            A c{t[K - 1][k]};
+            for (int j = K - 2; j >= 0; --j)
+                c = c * A{ntt_primes[j]} + A{t[j][k]};
+            if (negative)
+            {
+                A P{1};
+                for (int j = 0; j < K; ++j)
+                    P = P * A{ntt_primes[j]};
+                c = c - P;
+            }
+            return R(c);
+        }
+    }  // namespace detail
+
+    /*
+        Exact linear convolution of the integer sequences a and b, ie. the
+        product of the polynomials of coefficients a and b:
+        c[k] = sum_j a[j] b[k - j], k < na + nb - 1
+        The NTTs of the primes run in parallel with the policy pol, one per
+        thread, then the coefficients are rebuilt by blocks.
+
+        The number of primes is chosen from the bound
+        |c[k]| <= min(na, nb) max|a| max|b|
+        and R must hold it: a builtin integer type, __int128 included, or an
+        arbitrary precision type constructible from the unsigned integers,
+        with + - *. Throws if na + nb - 1 > 2^23 or if the bound does not fit
+        in a builtin R.
+    */
+    template <class R = long long, class policy, class I>
+    typename std::enable_if<execution::is_execution_policy<policy>::value,
+                            std::vector<R>>::type
+    integer_convolution(const policy& pol,
+                        const std::vector<I>& a,
+                        const std::vector<I>& b)
+    {
+        static_assert(std::is_integral<I>::value && sizeof(I) <= 8,
+                      "integer_convolution expects integers of 64 bits");
+        if (a.empty() || b.empty())
+            return {};
+        const std::size_t size = a.size() + b.size() - 1;
+        if (size > (std::size_t(1) << detail::ntt_primes_log))
+            throw fftx::error("integer_convolution: the size " +
+                              std::to_string(size) + " exceeds 2^" +
+                              std::to_string(detail::ntt_primes_log));
+        const int n = size;
+        int m = 1;
+        while (m < n)
+            m *= 2;
+
+        // c < 2^bits, and the primes hold 2c + 1
+        const int bits = detail::bit_length(a) + detail::bit_length(b) +
+                         (64 - __builtin_clzll(std::min(a.size(), b.size())));
+        if (bits > detail::result_digits<R>())
+            throw fftx::error("integer_convolution: the coefficients may "
+                              "need " +
+                              std::to_string(bits) + " bits");
+        int K = 0;
+        for (int held = 0; held < bits + 1; ++K)
+            held += 31 - __builtin_clz(detail::ntt_primes[K]);
+
+        // the residues, then the digits of the coefficients
+        std::vector<std::vector<std::uint32_t>> t(
+            K, std::vector<std::uint32_t>(n));
+        std::vector<std::uint32_t*> rows(K);
+        for (int i = 0; i < K; ++i)
+            rows[i] = t[i].data();
+
+        static constexpr auto residues = detail::residue_table<I>(
+            std::make_index_sequence<detail::ntt_primes_count>{});
+        detail::parallel_for(pol, K, 1, [&](int i0, int i1) {
+            for (int i = i0; i < i1; ++i)
+                residues[i](a, b, m, rows[i]);
+        });
+
+        static constexpr auto digits = detail::garner_table(
+            std::make_index_sequence<detail::ntt_primes_count - 1>{});
+        std::vector<R> c(n);
+        constexpr int grain = 1 << 12;
+        detail::parallel_for(pol, n, grain, [&](int k0, int k1) {
+            for (int i = 1; i < K; ++i)
+                digits[i - 1](rows.data(), k0, k1);
+            for (int k = k0; k < k1; ++k)
+                c[k] = detail::garner_value<R>(rows.data(), K, k);
+        });
+        return c;
+    }
+
+    /*
+        Exact linear convolution of the integer sequences a and b, see above.
+    */
+    template <class R = long long, class I>
+    std::vector<R> integer_convolution(const std::vector<I>& a,
+                                       const std::vector<I>& b)
+    {
+        return integer_convolution<R>(execution::seq, a, b);
+    }
+}  // namespace fftx
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fftx/exception.hpp>
+#include <fftx/fourstep.hpp>
+#include <fftx/plan.hpp>
+
+/*
+    Out-of-core FFT of the sequences larger than the memory, stored in a
+    file or in a memory mapped region.
+
+    The four-step decomposition n = n1 n2 of fourstep.hpp is done in two
+    passes over the data, each of them by slabs that fit in the given
+    amount of memory:
+    1. slabs of w columns of the n1 x n2 input: n1 segments of w elements
+       are read, the columns are transformed and multiplied by the
+       twiddle factors, and the slab is written transposed, ie. as w
+       contiguous rows of the n2 x n1 output.
+    2. slabs of h columns of the n2 x n1 output: n2 segments of h elements
+       are read, transformed along the columns and written back in place,
+       X[k1 + n1 k2] is then at its final position.
+    Every element is read and written twice, by segments of about
+    memory / sqrt(n) elements. The slabs are double buffered: the next one
+    is read and the previous one written while the current one is
+    transformed.
+*/
+
+namespace fftx
+{
+    namespace detail
+    {
+        /*
+            read(s, b), compute(s, b), write(s, b) for the slabs s < slabs,
+            where b = s % 2 is the buffer of the slab. The reading of s+1
+            and the writing of s-1 run while s is computed. There is at most
+            one read and one write at a time, a storage may not support
+            more.
+        */
+        template <class Read, class Compute, class Write>
+        void double_buffered(long long slabs,
+                             Read&& read,
+                             Compute&& compute,
+                             Write&& write)
+        {
+            if (slabs < 1)
+                return;
+            std::future<void> reading =
+                std::async(std::launch::async, read, 0LL, 0);
+            std::future<void> writing;
+            for (long long s = 0; s < slabs; ++s)
+            {
+                const int b = s % 2;
+                reading.get();
+                // the input buffer 1-b was released by the compute of s-1
+                if (s + 1 < slabs)
+                    reading =
+                        std::async(std::launch::async, read, s + 1, 1 - b);
+                // the output buffer b was released by the write of s-2,
+                // done before the write of s-1 started
+                compute(s, b);
+                if (writing.valid())
+                    writing.get();
+                writing = std::async(std::launch::async, write, s, b);
+            }
+            writing.get();
+        }
+
+        /*
+            elements [pos, pos+count) of a binary file of T
+        */
+        template <class T>
+        class file_reader
+        {
+            std::string path;
+            std::ifstream file;
+
+           public:
+            explicit file_reader(const std::string& path_) : path{path_}
+            {
+                // unbuffered: the segments are large, and a buffer could
+                // keep the values of another slab from before their write
+                file.rdbuf()->pubsetbuf(nullptr, 0);
+                file.open(path, std::ios::binary);
+                if (!file)
+                    throw fftx::error("cannot open " + path);
+            }
+
+            void operator()(long long pos, long long count, T* x)
+            {
+                file.seekg(pos * sizeof(T));
+                file.read(reinterpret_cast<char*>(x), count * sizeof(T));
+                if (!file)
+                    throw fftx::error("cannot read " + path);
+            }
+        };
+
+        template <class T>
+        class file_writer
+        {
+            std::string path;
+            std::fstream file;
+
+           public:
+            explicit file_writer(const std::string& path_) : path{path_}
+            {
+                file.rdbuf()->pubsetbuf(nullptr, 0);
+                file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+                if (!file)
+                    throw fftx::error("cannot open " + path);
+            }
+
+            void operator()(long long pos, long long count, const T* x)
+            {
+                file.seekp(pos * sizeof(T));
+                file.write(reinterpret_cast<const char*>(x),
+                           count * sizeof(T));
+                if (!file)
+                    throw fftx::error("cannot write " + path);
+            }
+        };
+
+        /*
+            The two passes of the out-of-core FFT of size n with 4 slab
+            buffers of the given number of elements. read(pos, count, x)
+            and write(pos, count, x) access the storage, a read and a write
+            may run at the same time.
+        */
+        template <class T>
+        class out_of_core_passes
+        {
+            long long n;
+            int n1, n2;
+            int w, h;  // columns of the slabs of the passes 1 and 2
+            plan<T> cols, rows;
+            four_step_twiddles<T> twiddles;
+            std::vector<T> in[2], out[2], work;
+
+            // n1, such that a slab holds a row and a column
+            static int split(long long n, long long slab)
+            {
+                const int n1 = four_step_split(n);
+                if (n / n1 > slab)
+                    throw fftx::error(
+                        "FFT_OutOfCore: the memory is too small for n=" +
+                        std::to_string(n));
+                return n1;
+            }
+
+           public:
+            out_of_core_passes(long long n_, const T e, long long slab)
+                : n{n_},
+                  n1{split(n_, slab)},
+                  n2{int(n_ / n1)},
+                  w{int(std::min<long long>(n2, slab / n1))},
+                  h{int(std::min<long long>(n1, slab / n2))},
+                  cols(n1, power(e, n2)),
+                  rows(n2, power(e, n1)),
+                  twiddles(n1, n2, e)
+            {
+                for (int b = 0; b < 2; ++b)
+                {
+                    in[b].resize(std::max<long long>((long long)n1 * w,
+                                                     (long long)n2 * h));
+                    out[b].resize(in[b].size());
+                }
+                work.resize(four_step_block * n2);
+            }
+
+            /*
+                FTs of the columns of the n1 x n2 input and twiddles, written
+                transposed
+            */
+            template <class Read, class Write>
+            void columns(Read& read, Write& write)
+            {
+                const long long slabs = (n2 + w - 1) / w;
+                auto width = [&](long long s) {
+                    return int(std::min<long long>(w, n2 - s * w));
+                };
+                double_buffered(
+                    slabs,
+                    [&](long long s, int b) {
+                        for (int j1 = 0; j1 < n1; ++j1)
+                            read((long long)j1 * n2 + s * w, width(s),
+                                 in[b].data() + (long long)j1 * width(s));
+                    },
+                    [&](long long s, int b) {
+                        const int ws = width(s);
+                        transpose(in[b].begin(), out[b].begin(), n1, ws);
+                        for (int c = 0; c < ws; ++c)
+                        {
+                            auto col = out[b].begin() + (long long)c * n1;
+                            cols.forward(col, col + n1);
+                            twiddles.apply(col, s * w + c, false);
+                        }
+                    },
+                    [&](long long s, int b) {
+                        write(s * w * n1, (long long)width(s) * n1,
+                              out[b].data());
+                    });
+            }
+
+            /*
+                FTs of the columns of the n2 x n1 output, in place
+            */
+            template <class Read, class Write>
+            void rows_in_place(Read& read, Write& write)
+            {
+                constexpr int block = four_step_block;
+                const long long slabs = (n1 + h - 1) / h;
+                auto height = [&](long long s) {
+                    return int(std::min<long long>(h, n1 - s * h));
+                };
+                double_buffered(
+                    slabs,
+                    [&](long long s, int b) {
+                        for (int j2 = 0; j2 < n2; ++j2)
+                            read((long long)j2 * n1 + s * h, height(s),
+                                 in[b].data() + (long long)j2 * height(s));
+                    },
+                    [&](long long s, int b) {
+                        const int hs = height(s);
+                        for (int c0 = 0; c0 < hs; c0 += block)
+                        {
+                            const int m = std::min(block, hs - c0);
+                            for (int j2 = 0; j2 < n2; ++j2)
+                                for (int c = 0; c < m; ++c)
+                                    work[c * n2 + j2] =
+                                        in[b][(long long)j2 * hs + c0 + c];
+                            for (int c = 0; c < m; ++c)
+                                rows.forward(work.begin() + c * n2,
+                                             work.begin() + (c + 1) * n2);
+                            for (int j2 = 0; j2 < n2; ++j2)
+                                for (int c = 0; c < m; ++c)
+                                    out[b][(long long)j2 * hs + c0 + c] =
+                                        work[c * n2 + j2];
+                        }
+                    },
+                    [&](long long s, int b) {
+                        for (int j2 = 0; j2 < n2; ++j2)
+                            write((long long)j2 * n1 + s * h, height(s),
+                                  out[b].data() + (long long)j2 * height(s));
+                    });
+            }
+        };
+
+        /*
+            elements of the slab buffers for the given memory in bytes
+        */
+        template <class T>
+        long long out_of_core_slab(std::size_t memory)
+        {
+            return memory / (4 * sizeof(T));
+        }
+    }  // namespace detail
+
+    /*
+        Out-of-core FFT of the binary file input, made of n values of type
+        T, to the file output, which is created or overwritten. About memory
+        bytes are used for the data, at least 4 sqrt(n) values of T.
+    */
+    template <class T>
+    void FFT_OutOfCore(const std::string& input,
+                       const std::string& output,
+                       const T e,
+                       std::size_t memory = std::size_t(1) << 30)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "FFT_OutOfCore stores the raw bytes of T");
+        if (input == output)
+            throw fftx::error("FFT_OutOfCore: the output must differ from "
+                              "the input");
+        const auto bytes = std::filesystem::file_size(input);
+        if (bytes == 0 || bytes % sizeof(T))
+            throw fftx::error("FFT_OutOfCore: " + input +
+                              " is not a sequence of values");
+
+        detail::out_of_core_passes<T> passes(
+            bytes / sizeof(T), e, detail::out_of_core_slab<T>(memory));
+        {
+            std::ofstream create(output, std::ios::binary);
+            if (!create)
+                throw fftx::error("cannot create " + output);
+        }
+        {
+            detail::file_reader<T> read(input);
+            detail::file_writer<T> write(output);
+            passes.columns(read, write);
+        }
+        detail::file_reader<T> read(output);
+        detail::file_writer<T> write(output);
+        passes.rows_in_place(read, write);
+    }
+
+    /*
+        Out-of-core FFT of [first, last) to [out, out + n), eg. two memory
+        mapped files. The ranges must not overlap. The data is accessed by
+        slabs of at most about memory bytes, in the order of the file
+        version, so that the pages of a mapping are read and written
+        sequentially by large blocks.
+    */
+    template <class iter1, class iter2, class T>
+    typename std::enable_if<!std::is_convertible<iter1, std::string>::value,
+                            void>::type
+    FFT_OutOfCore(iter1 first,
+                  iter1 last,
+                  iter2 out,
+                  const T e,
+                  std::size_t memory = std::size_t(1) << 30)
+    {
+        const long long n = std::distance(first, last);
+        if (n == 0)
+            return;
+        detail::out_of_core_passes<T> passes(
+            n, e, detail::out_of_core_slab<T>(memory));
+        auto read_in = [first](long long pos, long long count, T* x) {
+            std::copy(first + pos, first + pos + count, x);
+        };
+        auto read_out = [out](long long pos, long long count, T* x) {
+            std::copy(out + pos, out + pos + count, x);
+        };
+        auto write_out = [out](long long pos, long long count, const T* x) {
+            std::copy(x, x + count, out + pos);
+        };
+        passes.columns(read_in, write_out);
+        passes.rows_in_place(read_out, write_out);
+    }
+}  // namespace fftx
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+
+#include <fftx/execution.hpp>
+
+/*
+    Permutations of the data of the FFT algorithms: the bit reversal of the
+    power of two engines and the transposition of the multi-step and
+    multidimensional ones.
+*/
+
+namespace fftx
+{
+    /*
+        reverse the lowest nbits bits of i
+    */
+    inline int bit_reverse(int i, int nbits)
+    {
+        int j = 0;
+        for (int b = 0; b < nbits; i >>= 1, ++b)
+            j = (j << 1) | (i & 1);
+        return j;
+    }
+
+    /*
+        Bit reversal permutation with an incrementally generated reversed
+        index: j = reverse(i) is updated in O(1) amortized operations each
+        time i is incremented.
+        !!! n must be a power of 2
+    */
+    template <class iter>
+    void bit_reverse_incremental(iter first, iter last)
+    {
+        const int n = std::distance(first, last);
+        for (int i = 0, j = 0; i < n; ++i)
+        {
+            if (i < j)
+                std::swap(first[i], first[j]);
+
+            // j = reverse(i+1)
+            int bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j |= bit;
+        }
+    }
+
+    namespace detail
+    {
+        /*
+            the blocks b_first <= b < b_last of bit_reverse_cobra, the
+            blocks of different b are exchanged independently
+        */
+        template <int q, class iter>
+        void cobra_blocks(iter first, int nbits, int b_first, int b_last)
+        {
+            using T = typename std::iterator_traits<iter>::value_type;
+            constexpr int Q = 1 << q;
+
+            const int bbits = nbits - 2 * q;
+            const int a_shift = bbits + q;
+
+            int rev_q[Q];
+            for (int i = 0; i < Q; ++i)
+                rev_q[i] = bit_reverse(i, q);
+
+            std::array<T, Q * Q> buf;
+            for (int b = b_first; b < b_last; ++b)
+            {
+                const int rb = bit_reverse(b, bbits);
+                if (rb < b)
+                    continue;
+
+                // buf[rev(a)][c] = A[a, b, c]
+                for (int a = 0; a < Q; ++a)
+                {
+                    iter src = first + ((a << a_shift) | (b << q));
+                    T* dst = &buf[rev_q[a] * Q];
+                    for (int c = 0; c < Q; ++c)
+                        dst[c] = src[c];
+                }
+
+                // A[rev(c), rev(b), y] <-> buf[y][c]
+                for (int c = 0; c < Q; ++c)
+                {
+                    iter dst = first + ((rev_q[c] << a_shift) | (rb << q));
+                    for (int y = 0; y < Q; ++y)
+                        std::swap(dst[y], buf[y * Q + c]);
+                }
+
+                // A[rev(y), b, c] = buf[y][c]
+                for (int y = 0; y < Q; ++y)
+                {
+                    iter dst = first + ((rev_q[y] << a_shift) | (b << q));
+                    const T* src = &buf[y * Q];
+                    for (int c = 0; c < Q; ++c)
+                        dst[c] = src[c];
+                }
+            }
+        }
+    }  // namespace detail
+
+    /*
+        Cache optimal bit reversal (COBRA), see
+        Carter, Gatlin, "Towards an optimal bit-reversal permutation program"
+        (1998).
+
+        The index is split as i = (a, b, c) where a and c have q bits each.
+        For every middle part b the Q*Q elements with the same b, which lie in
+        Q contiguous runs of length Q, are gathered into a buffer and
+        exchanged with the block of the reversed middle part rev(b).
+        Every element of the input is then read and written in contiguous
+        runs of Q elements. With a parallel policy the middle parts b are
+        shared among the threads.
+        !!! n must be a power of 2 and n >= Q*Q
+    */
+    template <int q, class iter, class policy = execution::sequenced_policy>
+    void bit_reverse_cobra(iter first, iter last, const policy& pol = {})
+    {
+        const int n = std::distance(first, last);
+        int nbits = 0;
+        while ((1 << nbits) < n)
+            ++nbits;
+        const int blocks = 1 << (nbits - 2 * q);
+
+        detail::parallel_for(pol, blocks, 64, [&](int b_first, int b_last) {
+            detail::cobra_blocks<q>(first, nbits, b_first, b_last);
+        });
+    }
+
+    /*
+        Bit reversal permutation of the range [first, last).
+        !!! n must be a power of 2
+    */
+    template <class iter, class policy = execution::sequenced_policy>
+    void bit_reverse_permutation(iter first, iter last, const policy& pol = {})
+    {
+        constexpr int q = 5;
+        constexpr int cobra_threshold = 1 << 16;
+
+        if (std::distance(first, last) >= cobra_threshold)
+            bit_reverse_cobra<q>(first, last, pol);
+        else
+            bit_reverse_incremental(first, last);
+    }
+
+    /*
+        Bit reversal permutation of the two ranges [first, last) and
+        [first2, first2 + n), eg. the real and imaginary parts of split
+        complex data. The values are half the size of the complex ones:
+        COBRA pays off from smaller sizes, with smaller blocks below
+        2^16. The smallest sizes compute every reversed index once for both
+        ranges.
+        !!! n must be a power of 2
+    */
+    template <class iter>
+    void bit_reverse_permutation_split(iter first, iter last, iter first2)
+    {
+        const int n = std::distance(first, last);
+        if (n >= 1 << 16)
+        {
+            bit_reverse_cobra<5>(first, last);
+            bit_reverse_cobra<5>(first2, first2 + n);
+            return;
+        }
+        if (n >= 1 << 12)
+        {
+            bit_reverse_cobra<3>(first, last);
+            bit_reverse_cobra<3>(first2, first2 + n);
+            return;
+        }
+        for (int i = 0, j = 0; i < n; ++i)
+        {
+            if (i < j)
+            {
+                std::swap(first[i], first[j]);
+                std::swap(first2[i], first2[j]);
+            }
+
+            // j = reverse(i+1)
+            int bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j |= bit;
+        }
+    }
+
+    constexpr int transpose_tile = 32;
+
+    namespace detail
+    {
+        /*
+            out[c][r] = in[r][c] for the matrix in of rows x cols and the
+            rows c_first <= c < c_last of out, by tiles that fit in the L1
+            cache
+        */
+        template <class iter1, class iter2>
+        void transpose(iter1 in,
+                       iter2 out,
+                       const int rows,
+                       const int cols,
+                       const int c_first,
+                       const int c_last)
+        {
+            constexpr int b = transpose_tile;
+            for (int r0 = 0; r0 < rows; r0 += b)
+                for (int c0 = c_first; c0 < c_last; c0 += b)
+                {
+                    const int r1 = std::min(rows, r0 + b);
+                    const int c1 = std::min(c_last, c0 + b);
+                    for (int c = c0; c < c1; ++c)
+                        for (int r = r0; r < r1; ++r)
+                            out[(long long)c * rows + r] =
+                                in[(long long)r * cols + c];
+                }
+        }
+
+        template <class iter1, class iter2>
+        void transpose(iter1 in, iter2 out, const int rows, const int cols)
+        {
+            transpose(in, out, rows, cols, 0, cols);
+        }
+    }  // namespace detail
+}  // namespace fftx
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <fftx/1d.hpp>
+#include <fftx/exception.hpp>
+#include <fftx/execution.hpp>
+#include <fftx/math.hpp>
+
+namespace fftx
+{
+    /*
+        the plans up to this size run the FFT_fixed kernels of
+        primitives.hpp, through a jump table
+    */
+    constexpr int plan_fixed_limit = 16;
+
+    /*
+        Precomputed Fourier transform of size n. The constructor computes
+        - n <= plan_fixed_limit: e and e^(n-1), for the fixed-size kernels
+        - the complex sizes with a prime factor above bluestein_threshold:
+          the tables of Bluestein's algorithm
+        - the other powers of two: the twiddles of the radix-4 algorithm
+        - the other sizes: the radices of n, the digit-reversal
+          permutation, the powers e^k (k=0..n-1) and the Rader kernels of
+          the large prime radices, for the mixed radix algorithm
+        It is the only place where memory is allocated or an exception is
+        thrown, forward() and inverse() can then be called any number of
+        times.
+
+        e must be an n-root of unity (of the identity), ie.
+        for any x: x = e^n * x
+
+        The forward transform uses e, the inverse transform uses e^(n-1),
+        neither of them is normalized.
+
+        The plan owns a scratch buffer: the same plan must not be executed by
+        two threads at the same time.
+    */
+    template <class T>
+    class plan
+    {
+        int n;
+        std::vector<int> P;     // radices, in the order of the stages
+        std::vector<int> perm;  // input position -> digit reversed position
+        std::vector<T> W;       // W[k] = e^k
+        std::vector<T> Wi;      // Wi[k] = e^-k
+        std::vector<T> tw, twi;  // powers of two: radix-4 stage twiddles
+        // split data: the radix-4 or the mixed radix stage twiddles
+        std::vector<typename detail::real_part<T>::type> tw_re, tw_im;
+        std::vector<T> work;
+        std::vector<detail::prime_dft<T>> K, Ki;  // radices without codelet
+        std::vector<detail::bluestein<T>> blue;  // forward and inverse
+        std::vector<T> fixed;  // small sizes: e and e^(n-1)
+
+        template <class policy, class iter>
+        void execute(const policy& pol,
+                     iter first,
+                     iter last [[maybe_unused]],
+                     bool inv)
+        {
+            assert(std::distance(first, last) == n);
+            if (n == 1)
+                return;
+            if constexpr (!std::is_same<policy,
+                                        execution::sequenced_policy>::value)
+                if (n < parallel_threshold)
+                    return execute(execution::seq, first, last, inv);
+            if (!fixed.empty())
+                return detail::fixed_dispatch<plan_fixed_limit>(first, last,
+                                                                fixed[inv]);
+            if (!blue.empty())
+                return blue[inv](first, pol);
+            if (!tw.empty())
+                return detail::radix4(pol, first, n, inv ? twi : tw);
+
+            const auto& w = inv ? Wi : W;
+            auto& k = inv ? Ki : K;
+            for (int i = 0; i < n; ++i)
+                work[perm[i]] = first[i];
+
+            bool in_work = true;
+            int len = 1;
+            for (auto p : P)
+            {
+                if (in_work)
+                    detail::mixed_radix_stage(work.begin(), first, n, len, p,
+                                              w, k);
+                else
+                    detail::mixed_radix_stage(first, work.begin(), n, len, p,
+                                              w, k);
+                in_work = !in_work;
+                len *= p;
+            }
+            if (in_work)
+                std::copy(work.begin(), work.end(), first);
+        }
+
+        template <class iter>
+        void execute_split(iter re, iter im, bool inv)
+        {
+            static_assert(detail::is_complex<T>::value,
+                          "plan: split data expects a complex T");
+            if (n == 1)
+                return;
+            if (!fixed.empty())
+                return detail::fixed_dispatch_split<plan_fixed_limit>(
+                    re, im, n, fixed[inv]);
+            // the inverse is the forward FT with the real and imaginary
+            // parts exchanged
+            if (inv)
+                return execute_split(im, re, false);
+            if (!blue.empty())
+                return blue[0].split(re, im);
+            if (P.empty())
+                return detail::radix4_split(re, im, n, tw_re, tw_im);
+
+            // the stages run between the scratch, which holds the real parts
+            // and then the imaginary parts, and the data
+            using R = typename detail::real_part<T>::type;
+            R* s = reinterpret_cast<R*>(work.data());
+            R *xr = s, *xi = s + n, *yr = &re[0], *yi = &im[0];
+            for (int i = 0; i < n; ++i)
+            {
+                xr[perm[i]] = yr[i];
+                xi[perm[i]] = yi[i];
+            }
+            int len = 1;
+            for (auto p : P)
+            {
+                detail::mixed_radix_stage_split(xr, xi, yr, yi, n, len, p,
+                                                tw_re, tw_im, W, K);
+                std::swap(xr, yr);
+                std::swap(xi, yi);
+                len *= p;
+            }
+            if (xr == s)
+            {
+                std::copy(s, s + n, yr);
+                std::copy(s + n, s + 2 * n, yi);
+            }
+        }
+
+       public:
+        plan(int n_, const T e) : n{n_}
+        {
+            if (n < 1)
+                throw fftx::error("plan: n=" + std::to_string(n) +
+                                  " must be positive");
+
+            if (n > 1 && n <= plan_fixed_limit)
+            {
+                fixed.push_back(e);
+                if constexpr (detail::is_complex<T>::value)
+                    fixed.push_back(std::conj(e));
+                else
+                    fixed.push_back(power(e, n - 1));
+                return;
+            }
+
+            if constexpr (detail::is_complex<T>::value)
+            {
+                if (detail::use_bluestein<T>(n))
+                {
+                    // e^(n-1) = conj(e), without the round-off of power
+                    blue.emplace_back(n, e);
+                    blue.emplace_back(n, std::conj(e));
+                    return;
+                }
+            }
+
+            if (n > 1 && __builtin_popcount(n) == 1)
+            {
+                tw = detail::stage_twiddles(e, n);
+                if constexpr (detail::is_complex<T>::value)
+                {
+                    // e^-k = conj(e^k), exactly
+                    for (auto w : tw)
+                    {
+                        twi.push_back(std::conj(w));
+                        tw_re.push_back(w.real());
+                        tw_im.push_back(w.imag());
+                    }
+                }
+                else
+                    twi = detail::stage_twiddles(power(e, n - 1), n);
+                return;
+            }
+
+            P = detail::radices(n);
+            perm = detail::digit_reversal(n, P);
+            std::reverse(P.begin(), P.end());
+
+            W = root_powers(e, n, n);
+            Wi.assign(W.begin(), W.end());
+            std::reverse(Wi.begin() + 1, Wi.end());
+
+            if constexpr (detail::is_complex<T>::value)
+                std::tie(tw_re, tw_im) =
+                    detail::mixed_radix_twiddles_split(W, P);
+            work.resize(n);
+            K = detail::prime_kernels(P, W);
+            Ki = detail::prime_kernels(P, Wi);
+        }
+
+        int size() const { return n; }
+
+        template <class iter>
+        void forward(iter first, iter last)
+        {
+            execute(execution::seq, first, last, false);
+        }
+
+        template <class iter>
+        void inverse(iter first, iter last)
+        {
+            execute(execution::seq, first, last, true);
+        }
+
+        /*
+            With an execution policy, see execution.hpp. The powers of two
+            and Bluestein's algorithm run in parallel, the other sizes
+            serially.
+        */
+        template <class policy, class iter>
+        void forward(const policy& pol, iter first, iter last)
+        {
+            execute(pol, first, last, false);
+        }
+
+        template <class policy, class iter>
+        void inverse(const policy& pol, iter first, iter last)
+        {
+            execute(pol, first, last, true);
+        }
+
+        /*
+            The transforms on split complex data, see split.hpp: the real
+            parts in [re_first, re_last) and the imaginary parts from
+            im_first, both contiguous, T must be complex. They run serially.
+            Every size computes on the split data, without converting it:
+            the powers of two and Bluestein's algorithm with their split
+            kernels, the small sizes with FFT_fixed_split and the mixed radix
+            sizes with split stages between the data and the scratch.
+        */
+        template <class iter>
+        void forward_split(iter re_first,
+                           iter re_last [[maybe_unused]],
+                           iter im_first)
+        {
+            assert(std::distance(re_first, re_last) == n);
+            execute_split(re_first, im_first, false);
+        }
+
+        template <class iter>
+        void inverse_split(iter re_first,
+                           iter re_last [[maybe_unused]],
+                           iter im_first)
+        {
+            assert(std::distance(re_first, re_last) == n);
+            execute_split(re_first, im_first, true);
+        }
+    };
+}  // namespace fftx
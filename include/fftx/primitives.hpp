@@ -2,8 +2,14 @@
 
 #include <algorithm>
 #include <array>
+#include <complex>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <fftx/exception.hpp>
 #include <fftx/math.hpp>
 
 /*
@@ -38,6 +44,155 @@ namespace fftx
         out[0] = in[0];
     }
 
+    namespace detail
+    {
+        /*
+            number of prime factors of n, with multiplicity
+        */
+        constexpr std::size_t factor_count(std::size_t n)
+        {
+            std::size_t c = 0;
+            for (std::size_t p = 2; n > 1; ++p)
+                for (; n % p == 0; n /= p)
+                    ++c;
+            return c;
+        }
+
+        /*
+            prime factors of n in increasing order, as prime_factorization,
+            at compile time
+        */
+        template <std::size_t n>
+        constexpr std::array<std::size_t, factor_count(n)> fixed_factorization()
+        {
+            std::array<std::size_t, factor_count(n)> P{};
+            std::size_t i = 0, m = n;
+            for (std::size_t p = 2; m > 1; ++p)
+                for (; m % p == 0; m /= p)
+                    P[i++] = p;
+            return P;
+        }
+
+        /*
+            the digits of i in the mixed radix of the prime factors of n,
+            in reverse order: the input permutation of the iterative FFTs,
+            the bit reversal when n is a power of two
+        */
+        template <std::size_t n>
+        constexpr std::size_t reversed_digits(std::size_t i)
+        {
+            constexpr auto P = fixed_factorization<n>();
+            std::size_t j = 0;
+            for (std::size_t p : P)
+            {
+                j = j * p + i % p;
+                i /= p;
+            }
+            return j;
+        }
+
+        /*
+            J[i] = reversed_digits<n>(i), at compile time
+        */
+        template <std::size_t n>
+        constexpr std::array<std::size_t, n> digit_reversal()
+        {
+            std::array<std::size_t, n> J{};
+            for (std::size_t i = 0; i < n; ++i)
+                J[i] = reversed_digits<n>(i);
+            return J;
+        }
+    }  // namespace detail
+
+    /*
+        largest size of the compile-time permutation tables and of the
+        stack buffers of the fixed-size kernels. The larger tables would
+        exceed the constexpr evaluation limits of the compilers, and the
+        larger buffers the stacks of the threads: above it the kernels
+        compute the permutation on the fly and allocate their buffers.
+    */
+    constexpr std::size_t fixed_table_limit = 1 << 12;
+
+    namespace detail
+    {
+        /*
+            J[i] = reversed_digits<n>(i), a constant table up to
+            fixed_table_limit
+        */
+        template <std::size_t n>
+        struct fixed_permutation
+        {
+            std::size_t operator[](std::size_t i) const
+            {
+                if constexpr (n <= fixed_table_limit)
+                {
+                    static constexpr auto J = digit_reversal<n>();
+                    return J[i];
+                }
+                else
+                    return reversed_digits<n>(i);
+            }
+        };
+
+        /*
+            buffer of n values of the fixed-size kernels, an array up to
+            fixed_table_limit and a vector above
+        */
+        template <class T, std::size_t n>
+        auto fixed_buffer()
+        {
+            if constexpr (n <= fixed_table_limit)
+                return std::array<T, n>{};
+            else
+                return std::vector<T>(n);
+        }
+
+        /*
+            FT of odd size n for the complex numbers.
+            With t_k = x_k + x_(n-k) and d_k = x_k - x_(n-k) the outputs q
+            and n-q share the same real and imaginary parts
+            a_q = x_0 + sum_k Re(e^qk) t_k,  b_q = sum_k Im(e^qk) d_k
+            out_q = a_q + i b_q,  out_(n-q) = a_q - i b_q
+            that need only products of real and complex numbers.
+        */
+        template <std::size_t n, class iter1, class iter2, class T>
+        void FFT_odd_complex_fixed(iter1 in, iter2 out, const T e)
+        {
+            constexpr std::size_t h = (n - 1) / 2;
+            std::array<T, n> w;
+            w[0] = T(1);
+            for (std::size_t k = 1; k < n; ++k)
+                w[k] = w[k - 1] * e;
+
+            const T x0 = in[0];
+            std::array<T, h + 1> t, d;
+            for (std::size_t k = 1; k <= h; ++k)
+            {
+                T a = in[k], b = in[n - k];
+                t[k] = a + b;
+                d[k] = a - b;
+            }
+
+            T s = x0;
+            for (std::size_t k = 1; k <= h; ++k)
+                s += t[k];
+            out[0] = s;
+
+            for (std::size_t q = 1; q <= h; ++q)
+            {
+                T a = x0, b{0};
+                for (std::size_t k = 1; k <= h; ++k)
+                {
+                    const T& wqk = w[q * k % n];
+                    a += wqk.real() * t[k];
+                    b += wqk.imag() * d[k];
+                }
+                out[q] = T(a.real() - b.imag(), a.imag() + b.real());
+                out[n - q] = T(a.real() + b.imag(), a.imag() - b.real());
+            }
+        }
+    }  // namespace detail
+
     template <std::size_t n, class iter1, class iter2, class T>
     typename std::enable_if<n == 2, void>::type FFT_Handwritten_fixed(iter1 in,
                                                                       iter2 out,
@@ -47,7 +202,7 @@ namespace fftx
         std::array<T, n> x;
         std::copy(in, in + n, x.begin());
         out[0] = x[0] + x[1];
-        out[1] = x[0] + e * x[1];
+        out[1] = detail::minus(x[0], x[1], e);
     }
 
     template <std::size_t n, class iter1, class iter2, class T>
@@ -55,6 +210,9 @@ namespace fftx
                                                                       iter2 out,
                                                                       const T e)
     {
+        if constexpr (detail::is_complex<T>::value)
+            return detail::FFT_odd_complex_fixed<n>(in, out, e);
+
         // we use x in case 'in' and 'out' point to the same location
         std::array<T, n> x;
         std::copy(in, in + n, x.begin());
@@ -70,16 +228,16 @@ namespace fftx
                                                                       const T e)
     {
         std::array<T, n> x;
-        T e2 = e * e, e3 = e2 * e;
+        T e2 = e * e;
         x[0] = in[0] + in[2];
         x[1] = in[1] + in[3];
-        x[2] = in[0] + e2 * in[2];
-        x[3] = in[1] + e2 * in[3];
+        x[2] = detail::minus(in[0], in[2], e2);
+        x[3] = detail::mul_j(e, detail::minus(in[1], in[3], e2));
 
         out[0] = x[0] + x[1];
-        out[1] = x[2] + e * x[3];
-        out[2] = x[0] + e2 * x[1];
-        out[3] = x[2] + e3 * x[3];
+        out[1] = x[2] + x[3];
+        out[2] = detail::minus(x[0], x[1], e2);
+        out[3] = detail::minus(x[2], x[3], e2);
     }
 
     template <std::size_t n, class iter1, class iter2, class T>
@@ -87,6 +245,9 @@ namespace fftx
                                                                       iter2 out,
                                                                       const T e)
     {
+        if constexpr (detail::is_complex<T>::value)
+            return detail::FFT_odd_complex_fixed<n>(in, out, e);
+
         std::array<T, n> x;
         T e2 = e * e, e3 = e2 * e, e4 = e3 * e;
         std::copy(in, in + n, x.begin());
@@ -111,18 +272,18 @@ namespace fftx
         T e2 = e * e, e3 = e2 * e, e4 = e2 * e2, e5 = e4 * e;
 
         x[0] = in[0] + in[3];
-        x[1] = in[0] + e3 * in[3];
+        x[1] = detail::minus(in[0], in[3], e3);
         x[2] = in[1] + in[4];
-        x[3] = in[1] + e3 * in[4];
+        x[3] = detail::minus(in[1], in[4], e3);
         x[4] = in[2] + in[5];
-        x[5] = in[2] + e3 * in[5];
+        x[5] = detail::minus(in[2], in[5], e3);
 
         out[0] = x[0] + x[2] + x[4];
         out[2] = x[0] + e2 * x[2] + e4 * x[4];
         out[4] = x[0] + e4 * x[2] + e2 * x[4];
 
         out[1] = x[1] + e * x[3] + e2 * x[5];
-        out[3] = x[1] + e3 * x[3] + x[5];
+        out[3] = detail::minus(x[1] + x[5], x[3], e3);
         out[5] = x[1] + e5 * x[3] + e4 * x[5];
     }
 
@@ -131,6 +292,9 @@ namespace fftx
                                                                       iter2 out,
                                                                       const T e)
     {
+        if constexpr (detail::is_complex<T>::value)
+            return detail::FFT_odd_complex_fixed<n>(in, out, e);
+
         std::array<T, n> x;
         T e2 = e * e, e3 = e2 * e, e4 = e3 * e, e5 = e4 * e, e6 = e5 * e;
         std::copy(in, in + n, x.begin());
@@ -178,119 +342,741 @@ namespace fftx
 
     /*
         fixed-size FFT with n a power of two
+        the bit reversal is a constant table, the roots e^(n/len) of the
+        passes are kept in an array: the kernel does not allocate, up to
+        fixed_table_limit
     */
     template <std::size_t n, class iter1, class iter2, class T>
     void FFT_Power2_fixed(iter1 in, iter2 out, const T e)
     {
-        if (n == 1)
-        {
+        if constexpr (n == 1)
             out[0] = in[0];
-            return;
+        else
+        {
+            constexpr detail::fixed_permutation<n> J;
+            // n = 2^nbits
+            constexpr std::size_t nbits = detail::factor_count(n);
+
+            auto x = detail::fixed_buffer<T, n>();
+            std::copy(in, in + n, x.begin());
+            for (std::size_t i = 0; i < n; ++i)
+                if (i < J[i])
+                    std::swap(x[i], x[J[i]]);
+
+            // e2[k] = e^(n / 2^k)
+            std::array<T, nbits + 1> e2;
+            e2[nbits] = e;
+            for (std::size_t k = nbits; k > 0; --k)
+                e2[k - 1] = e2[k] * e2[k];
+            const T f = e2[1];
+
+            for (std::size_t len = 2, k = 1; len <= n; len <<= 1, ++k)
+            {
+                for (std::size_t i = 0; i < n; i += len)
+                {
+                    {
+                        // j=0
+                        T &u = x[i], &v = x[i + len / 2];
+                        T Bu = u, Bv = v;
+                        u = Bu + Bv;
+                        v = detail::minus(Bu, Bv, f);
+                    }
+                    T ej = e2[k];
+                    for (std::size_t j = 1; j < len / 2; ++j)
+                    {
+                        T &u = x[i + j], &v = x[i + j + len / 2];
+                        T Bu = u, Bv = v * ej;
+                        u = Bu + Bv;
+                        v = detail::minus(Bu, Bv, f);
+                        ej *= e2[k];
+                    }
+                }
+            }
+            std::copy(x.begin(), x.end(), out);
         }
-        std::array<T, n> x;
-        std::copy(in, in + n, x.begin());
+    }
 
-        T f = power(e, n / 2);
-        int nbits = 0;
-        std::vector<T> e2{e};
-        for (int m = n / 2; m > 0; m >>= 1, ++nbits)
-            e2.push_back(e2.back() * e2.back());
+    namespace detail
+    {
+        /*
+            the complex number *re + i *im of split data, read and written
+            in place
+        */
+        template <class riter>
+        class split_reference
+        {
+            using R = typename std::iterator_traits<riter>::value_type;
+            riter re, im;
 
-        std::reverse(e2.begin(), e2.end());
+           public:
+            split_reference(riter re_, riter im_) : re{re_}, im{im_} {}
 
-        for (std::size_t i = 0; i < n; ++i)
+            operator std::complex<R>() const { return {*re, *im}; }
+            split_reference& operator=(const std::complex<R>& z)
+            {
+                *re = z.real();
+                *im = z.imag();
+                return *this;
+            }
+            split_reference& operator=(const split_reference& b)
+            {
+                return *this = std::complex<R>(b);
+            }
+        };
+
+        /*
+            Random access iterator over the complex numbers of the split
+            data re, im. The kernels that read and write their complex
+            values one at a time run on it as on interleaved data, without
+            converting the arrays.
+        */
+        template <class riter>
+        class split_iterator
         {
-            std::size_t ib = i, j = 0;
+            riter re, im;
+            long long i = 0;
+
+           public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::complex<
+                typename std::iterator_traits<riter>::value_type>;
+            using difference_type = long long;
+            using pointer = void;
+            using reference = split_reference<riter>;
+
+            split_iterator() = default;
+            split_iterator(riter re_, riter im_, long long i_ = 0)
+                : re{re_}, im{im_}, i{i_}
+            {
+            }
+
+            reference operator*() const { return {re + i, im + i}; }
+            reference operator[](long long k) const
+            {
+                return {re + (i + k), im + (i + k)};
+            }
+
+            split_iterator& operator++()
+            {
+                ++i;
+                return *this;
+            }
+            split_iterator& operator--()
+            {
+                --i;
+                return *this;
+            }
+            split_iterator operator++(int) { return {re, im, i++}; }
+            split_iterator operator--(int) { return {re, im, i--}; }
+            split_iterator& operator+=(long long k)
+            {
+                i += k;
+                return *this;
+            }
+            split_iterator& operator-=(long long k)
+            {
+                i -= k;
+                return *this;
+            }
+
+            friend split_iterator operator+(split_iterator a, long long k)
+            {
+                return a += k;
+            }
+            friend split_iterator operator+(long long k, split_iterator a)
+            {
+                return a += k;
+            }
+            friend split_iterator operator-(split_iterator a, long long k)
+            {
+                return a -= k;
+            }
+            friend long long operator-(const split_iterator& a,
+                                       const split_iterator& b)
+            {
+                return a.i - b.i;
+            }
 
-            for (int b = 0; b < nbits; ib >>= 1, ++b)
-                j = (j << 1) | (ib & 1);
+            friend bool operator==(const split_iterator& a,
+                                   const split_iterator& b)
+            {
+                return a.i == b.i;
+            }
+            friend bool operator!=(const split_iterator& a,
+                                   const split_iterator& b)
+            {
+                return a.i != b.i;
+            }
+            friend bool operator<(const split_iterator& a,
+                                  const split_iterator& b)
+            {
+                return a.i < b.i;
+            }
+            friend bool operator>(const split_iterator& a,
+                                  const split_iterator& b)
+            {
+                return a.i > b.i;
+            }
+            friend bool operator<=(const split_iterator& a,
+                                   const split_iterator& b)
+            {
+                return a.i <= b.i;
+            }
+            friend bool operator>=(const split_iterator& a,
+                                   const split_iterator& b)
+            {
+                return a.i >= b.i;
+            }
+        };
+    }  // namespace detail
+
+    /*
+        fixed-size FFT with n a power of two, on split complex data: the real
+        and imaginary parts are in the separate ranges re and im.
+        Every butterfly is made of real operations on contiguous arrays,
+        which the compiler vectorizes without shuffles.
+    */
+    template <std::size_t n, class iter1, class iter2, class R>
+    void FFT_Power2_fixed_split(iter1 re_in,
+                                iter1 im_in,
+                                iter2 re_out,
+                                iter2 im_out,
+                                const std::complex<R> e)
+    {
+        constexpr detail::fixed_permutation<n> J;
+        auto xr = detail::fixed_buffer<R, n>();
+        auto xi = detail::fixed_buffer<R, n>();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            xr[J[i]] = re_in[i];
+            xi[J[i]] = im_in[i];
+        }
 
-            if (i < j)
-                std::swap(x[i], x[j]);
+        // w_j = e^j, j < n/2
+        constexpr std::size_t h = n > 1 ? n / 2 : 1;
+        auto wr = detail::fixed_buffer<R, h>();
+        auto wi = detail::fixed_buffer<R, h>();
+        std::complex<R> w(1);
+        for (std::size_t j = 0; j < h; ++j, w *= e)
+        {
+            wr[j] = w.real();
+            wi[j] = w.imag();
         }
-        for (std::size_t len = 2, k = 1; len <= n; len <<= 1, ++k)
+
+        for (std::size_t len = 2; len <= n; len <<= 1)
         {
+            const std::size_t m = len / 2, s = n / len;
             for (std::size_t i = 0; i < n; i += len)
-            {
+                for (std::size_t j = 0; j < m; ++j)
                 {
-                    // j=0
-                    T &u = x[i], &v = x[i + len / 2];
-                    T Bu = u, Bv = v;
-                    u = Bu + Bv;
-                    v = Bu + Bv * f;
+                    const std::size_t u = i + j, v = u + m;
+                    const R vr = xr[v] * wr[j * s] - xi[v] * wi[j * s];
+                    const R vi = xr[v] * wi[j * s] + xi[v] * wr[j * s];
+                    xr[v] = xr[u] - vr;
+                    xi[v] = xi[u] - vi;
+                    xr[u] += vr;
+                    xi[u] += vi;
                 }
-                T ej = e2[k];
-                for (std::size_t j = 1; j < len / 2; ++j)
-                {
-                    T &u = x[i + j], &v = x[i + j + len / 2];
-                    T Bu = u, Bv = v * ej;
-                    u = Bu + Bv;
-                    v = Bu + Bv * f;
-                    ej *= e2[k];
-                }
-            }
         }
-        std::copy(x.begin(), x.end(), out);
+        std::copy(xr.begin(), xr.end(), re_out);
+        std::copy(xi.begin(), xi.end(), im_out);
     }
 
     /*
         fixed-size FFT with n any number
+        the factorization of n and the input permutation are computed at
+        compile time and the buffers are arrays: the kernel does not
+        allocate, up to fixed_table_limit
     */
     template <std::size_t n, class iter1, class iter2, class T>
     void FFT_Iterative_fixed(iter1 in, iter2 out, const T e)
     {
-        if (n == 1)
+        if constexpr (n == 1)
             out[0] = in[0];
-        std::vector<T> B(n), B_old(n);
-        auto P = prime_factorization(n);
-
-        /* reorder input  */
-        for (std::size_t i = 0; i < n; ++i)
+        else
         {
-            int j = 0, k = i;
-            for (auto p : P)
-            {
-                j = j * p + k % p;
-                k /= p;
-            }
-            B[j] = in[i];
-        }
-
-        std::reverse(P.begin(), P.end());
+            static constexpr auto P = detail::fixed_factorization<n>();
+            constexpr detail::fixed_permutation<n> J;
+            auto B0 = detail::fixed_buffer<T, n>();
+            auto B1 = detail::fixed_buffer<T, n>();
+            T *B = B0.data(), *B_old = B1.data();
 
-        /* fft */
-        std::size_t len = 1;
-        for (auto p : P)
-        {
-            int len_old = len;
-            len *= p;
-            std::swap(B, B_old);
-            T e2 = power(e, n / len);  // len<=n and len divides n
+            /* reorder input  */
+            for (std::size_t i = 0; i < n; ++i)
+                B[J[i]] = in[i];
 
-            for (std::size_t i = 0; i < n; i += len)
+            /* fft, the factors in decreasing order */
+            std::size_t len = 1;
+            for (std::size_t s = P.size(); s-- > 0;)
             {
+                const int p = P[s];
+                const std::size_t len_old = len;
+                len *= p;
+                std::swap(B, B_old);
+                T e2 = power(e, n / len);  // len<=n and len divides n
+
+                for (std::size_t i = 0; i < n; i += len)
                 {
-                    // j =0
-                    T b = B_old[i + (p - 1) * len_old];
-                    for (int k = p - 2; k >= 0; --k)
                     {
-                        b += B_old[i + k * len_old];
+                        // j =0
+                        T b = B_old[i + (p - 1) * len_old];
+                        for (int k = p - 2; k >= 0; --k)
+                        {
+                            b += B_old[i + k * len_old];
+                        }
+                        B[i] = b;
                     }
-                    B[i] = b;
-                }
-                T ej = e2;
-                for (std::size_t j = 1; j < len; ++j, ej *= e2)
-                {
-                    T b = B_old[i + (p - 1) * len_old + j % len_old];
-                    for (int k = p - 2; k >= 0; --k)
+                    T ej = e2;
+                    for (std::size_t j = 1; j < len; ++j, ej *= e2)
                     {
-                        b = b * ej + B_old[i + k * len_old + j % len_old];
+                        T b = B_old[i + (p - 1) * len_old + j % len_old];
+                        for (int k = p - 2; k >= 0; --k)
+                        {
+                            b = b * ej + B_old[i + k * len_old + j % len_old];
+                        }
+                        B[i + j] = b;
                     }
-                    B[i + j] = b;
                 }
             }
+
+            std::copy(B, B + n, out);
+        }
+    }
+
+    namespace detail
+    {
+        /*
+            f(i) for i < n, with i a std::integral_constant, so that the
+            loop is unrolled and i is a constant expression in f
+        */
+        template <class F, std::size_t... i>
+        void unroll(F&& f, std::index_sequence<i...>)
+        {
+            (f(std::integral_constant<std::size_t, i>{}), ...);
+        }
+
+        template <std::size_t n, class F>
+        void unroll(F&& f)
+        {
+            unroll(f, std::make_index_sequence<n>{});
+        }
+
+        /*
+            w[k] = e^k, k < n, with n > 1, computed as w[k/2] w[k-k/2]: the
+            round-off of a power grows with log(k) and not with k
+        */
+        template <std::size_t n, class T>
+        std::array<T, n> fixed_powers(const T e)
+        {
+            std::array<T, n> w;
+            w[1] = e;
+            for (std::size_t k = 2; k < n; ++k)
+                w[k] = w[k / 2] * w[k - k / 2];
+            w[0] = w[n - 1] * e;
+            return w;
+        }
+
+        /*
+            radix of the first step of the codelet of size n: 4 when it
+            divides n, else the smallest prime factor of n
+        */
+        constexpr std::size_t codelet_radix(std::size_t n)
+        {
+            if (n % 4 == 0)
+                return 4;
+            for (std::size_t p = 2; p * p <= n; ++p)
+                if (n % p == 0)
+                    return p;
+            return n;
+        }
+
+        /*
+            w[m] x, where w holds the powers of the root of order N. The
+            products by 1, -1 and +-i of the complex numbers are removed at
+            compile time.
+        */
+        template <std::size_t N, std::size_t m, class T>
+        T codelet_twiddle(const std::array<T, N>& w, const T& x)
+        {
+            constexpr std::size_t r = m % N;
+            if constexpr (r == 0)
+                return x;
+            else if constexpr (is_complex<T>::value && 2 * r == N)
+                return -x;
+            else if constexpr (is_complex<T>::value && 4 * r % N == 0)
+                return mul_j(w[r], x);
+            else
+                return x * w[r];
+        }
+
+        /*
+            in-place FT of the p values t with the root w[R] of order p,
+            p = 2, 4 or a prime, written out term by term
+        */
+        template <std::size_t N, std::size_t p, std::size_t R, class T>
+        void codelet_dft(const std::array<T, N>& w, std::array<T, p>& t)
+        {
+            if constexpr (p == 2)
+            {
+                const T a = t[0], b = t[1];
+                t[0] = a + b;
+                t[1] = minus(a, b, w[N / 2]);
+            }
+            else if constexpr (p == 4)
+            {
+                const T& f = w[N / 2];
+                const T a = t[0] + t[2], b = minus(t[0], t[2], f);
+                const T c = t[1] + t[3];
+                const T d = mul_j(w[R], minus(t[1], t[3], f));
+                t[0] = a + c;
+                t[1] = b + d;
+                t[2] = minus(a, c, f);
+                t[3] = minus(b, d, f);
+            }
+            else if constexpr (is_complex<T>::value)
+            {
+                // same as FFT_odd_complex_fixed
+                constexpr std::size_t h = (p - 1) / 2;
+                std::array<T, h + 1> s, d;
+                unroll<h>([&](auto k) {
+                    s[k + 1] = t[k + 1] + t[p - 1 - k];
+                    d[k + 1] = t[k + 1] - t[p - 1 - k];
+                });
+                const T x0 = t[0];
+                t[0] = x0;
+                unroll<h>([&](auto k) { t[0] += s[k + 1]; });
+                unroll<h>([&](auto q) {
+                    T a = x0, b{};
+                    unroll<h>([&](auto k) {
+                        constexpr std::size_t m = R * (q + 1) * (k + 1) % N;
+                        a += w[m].real() * s[k + 1];
+                        b += w[m].imag() * d[k + 1];
+                    });
+                    t[q + 1] = T(a.real() - b.imag(), a.imag() + b.real());
+                    t[p - 1 - q] = T(a.real() + b.imag(), a.imag() - b.real());
+                });
+            }
+            else
+            {
+                const std::array<T, p> x = t;
+                unroll<p - 1>([&](auto q) {
+                    T b = x[0];
+                    unroll<p - 1>([&](auto j) {
+                        b += codelet_twiddle<N, R * (q + 1) * (j + 1)>(
+                            w, x[j + 1]);
+                    });
+                    t[q + 1] = b;
+                });
+                unroll<p - 1>([&](auto j) { t[0] += x[j + 1]; });
+            }
         }
 
-        std::copy(B.begin(), B.end(), out);
+        /*
+            Codelet: FT of size n with the root w[S], S n = N, of the
+            values x[O + j I], j < n, into z[Q + k], k < n, with y as
+            scratch of at least Q + n values.
+            Decimation in time with the radix p of codelet_radix and
+            m = n / p: p codelets of size m into y, then m FTs of size p of
+            the values multiplied by the twiddles w[S r k]. Every index is a
+            constant, the whole transform is a straight sequence of
+            operations. x is read before z is written.
+        */
+        template <std::size_t N,
+                  std::size_t n,
+                  std::size_t S,
+                  std::size_t I,
+                  std::size_t O,
+                  std::size_t Q,
+                  class iter1,
+                  class iter2,
+                  class T,
+                  std::size_t M>
+        void codelet(const std::array<T, N>& w,
+                     iter1 x,
+                     std::array<T, M>& y,
+                     iter2 z)
+        {
+            if constexpr (n == 1)
+                z[Q] = x[O];
+            else
+            {
+                constexpr std::size_t p = codelet_radix(n), m = n / p;
+                unroll<p>([&](auto r) {
+                    codelet<N, m, S * p, I * p, O + r * I, Q + r * m>(
+                        w, x, y, y.begin());
+                });
+                unroll<m>([&](auto k) {
+                    std::array<T, p> t;
+                    unroll<p>([&](auto r) {
+                        t[r] = codelet_twiddle<N, S * r * k>(w, y[Q + r * m + k]);
+                    });
+                    codelet_dft<N, p, S * m>(w, t);
+                    unroll<p>([&](auto q) { z[Q + q * m + k] = t[q]; });
+                });
+            }
+        }
+    }  // namespace detail
+
+    /*
+        fixed-size FFT with n any number, generated at compile time: the
+        codelet is fully unrolled, the twiddles are read from one table of
+        the powers of e and the products by the trivial twiddles are
+        removed
+    */
+    template <std::size_t n,
+              std::size_t s,
+              class iter1,
+              class iter2,
+              class T,
+              std::size_t N>
+    [[gnu::flatten]] void FFT_Codelet_fixed(iter1 in,
+                                            iter2 out,
+                                            const std::array<T, N>& w);
+
+    template <std::size_t n, class iter1, class iter2, class T>
+    [[gnu::flatten]] void FFT_Codelet_fixed(iter1 in, iter2 out, const T e)
+    {
+        static_assert(n > 0, "FFT_Codelet_fixed expects n>0");
+        if constexpr (n == 1)
+            out[0] = in[0];
+        else
+            FFT_Codelet_fixed<n, 1>(in, out, detail::fixed_powers<n>(e));
+    }
+
+    /*
+        the same with the root w[s] of the table w of the N = n s powers of
+        a root of order N, eg. the table of an enclosing transform, which
+        is then not rebuilt
+    */
+    template <std::size_t n,
+              std::size_t s,
+              class iter1,
+              class iter2,
+              class T,
+              std::size_t N>
+    [[gnu::flatten]] void FFT_Codelet_fixed(iter1 in,
+                                            iter2 out,
+                                            const std::array<T, N>& w)
+    {
+        static_assert(n > 0 && n * s == N,
+                      "FFT_Codelet_fixed expects n s = N > 0");
+        std::array<T, n> y;
+        detail::codelet<N, n, s, 1, 0, 0>(w, in, y, out);
+    }
+
+    /*
+        sizes of the codelets of FFT_fixed and of its runtime dispatch
+    */
+    constexpr std::size_t fixed_limit = 64;
+
+    template <std::size_t n, class iter1, class iter2, class T>
+    void FFT_fixed(iter1 in, iter2 out, const T e);
+
+    namespace detail
+    {
+        /*
+            the largest divisor of n not above fixed_limit
+        */
+        constexpr std::size_t fixed_split(std::size_t n)
+        {
+            std::size_t d = fixed_limit;
+            while (n % d)
+                --d;
+            return d;
+        }
+
+        template <std::size_t n, std::size_t s, class iter1, class iter2,
+                  class T, std::size_t N>
+        void fixed_level(iter1 in, iter2 out, const std::array<T, N>& w);
+
+        /*
+            FT of size n = n1 n2 with the root w[s], w the N = n s powers of
+            the root of the top level: x[n2 j1 + j2] -> X[k1 + n1 k2], the
+            n2 FTs of size n1 of the columns j2, multiplied by e^(j2 k1),
+            then the n1 FTs of size n2 of the rows k1. All the levels read
+            their twiddles in w.
+        */
+        template <std::size_t n1,
+                  std::size_t n2,
+                  std::size_t s,
+                  class iter1,
+                  class iter2,
+                  class T,
+                  std::size_t N>
+        void fixed_composition(iter1 in, iter2 out, const std::array<T, N>& w)
+        {
+            constexpr std::size_t n = n1 * n2;
+            std::array<T, n> z;  // z[k1 n2 + j2]
+            std::array<T, n1> col;
+            for (std::size_t j2 = 0; j2 < n2; ++j2)
+            {
+                for (std::size_t j1 = 0; j1 < n1; ++j1)
+                    col[j1] = in[j1 * n2 + j2];
+                fixed_level<n1, s * n2>(col.begin(), col.begin(), w);
+                z[j2] = col[0];
+                for (std::size_t k1 = 1; k1 < n1; ++k1)
+                    z[k1 * n2 + j2] = j2 ? col[k1] * w[s * j2 * k1] : col[k1];
+            }
+            for (std::size_t k1 = 0; k1 < n1; ++k1)
+            {
+                auto row = z.begin() + k1 * n2;
+                fixed_level<n2, s * n1>(row, row, w);
+                for (std::size_t k2 = 0; k2 < n2; ++k2)
+                    out[k1 + n1 * k2] = row[k2];
+            }
+        }
+
+        /*
+            FT of size n with the root w[s] inside a composition: the
+            compositions and the codelets of FFT_fixed share the table w
+        */
+        template <std::size_t n, std::size_t s, class iter1, class iter2,
+                  class T, std::size_t N>
+        void fixed_level(iter1 in, iter2 out, const std::array<T, N>& w)
+        {
+            if constexpr (n > fixed_limit && fixed_split(n) > 1)
+                fixed_composition<fixed_split(n), n / fixed_split(n), s>(
+                    in, out, w);
+            else if constexpr (n > 4 && n != 6 && n <= fixed_limit)
+                FFT_Codelet_fixed<n, s>(in, out, w);
+            else
+                FFT_fixed<n>(in, out, w[s]);
+        }
+    }  // namespace detail
+
+    /*
+        fixed-size FFT with n any number, the kernel is chosen at compile
+        time from n:
+        - n = 1..4, 6: the handwritten kernels, the fastest ones there
+        - n <= fixed_limit: the codelets
+        - the other sizes: a composition n = n1 n2 of FFT_fixed<n1> and
+          FFT_fixed<n2>, with n1 the largest divisor of n not above
+          fixed_limit, so that the leaves are codelets
+        - the primes above fixed_limit: the iterative kernel
+        The twiddles of a composition are computed once, in a table of n
+        powers of e that its levels and its codelets share. n must not
+        exceed fixed_table_limit, the kernel works on the stack.
+        The powers of two are composed too: the leaves are then radix-4
+        codelets, fully unrolled, which measured faster than the radix-2
+        loops of FFT_Power2_fixed at every size, eg. 2.9 against 4.0 us
+        for n = 256 and 79 against 108 us for n = 4096 (complex<double>).
+    */
+    template <std::size_t n, class iter1, class iter2, class T>
+    void FFT_fixed(iter1 in, iter2 out, const T e)
+    {
+        static_assert(n > 0, "FFT_fixed expects n>0");
+        static_assert(n <= fixed_table_limit,
+                      "FFT_fixed expects n <= fixed_table_limit, use plan");
+        if constexpr (n <= 4 || n == 6)
+            FFT_Handwritten_fixed<n>(in, out, e);
+        else if constexpr (n <= fixed_limit)
+            FFT_Codelet_fixed<n>(in, out, e);
+        else if constexpr (detail::fixed_split(n) > 1)
+            detail::fixed_level<n, 1>(in, out, detail::fixed_powers<n>(e));
+        else
+            FFT_Iterative_fixed<n>(in, out, e);
+    }
+
+    /*
+        FFT_Codelet_fixed on split complex data: the codelet reads its
+        inputs from re_in, im_in and writes its outputs to re_out, im_out
+        one at a time, the arrays are not converted
+    */
+    template <std::size_t n, class iter1, class iter2, class R>
+    void FFT_Codelet_fixed_split(iter1 re_in,
+                                 iter1 im_in,
+                                 iter2 re_out,
+                                 iter2 im_out,
+                                 const std::complex<R> e)
+    {
+        FFT_Codelet_fixed<n>(detail::split_iterator<iter1>(re_in, im_in),
+                             detail::split_iterator<iter2>(re_out, im_out),
+                             e);
+    }
+
+    /*
+        FFT_fixed on split complex data, with the same kernels on the split
+        values except for the handwritten sizes, done by the codelets,
+        which read every input once
+    */
+    template <std::size_t n, class iter1, class iter2, class R>
+    void FFT_fixed_split(iter1 re_in,
+                         iter1 im_in,
+                         iter2 re_out,
+                         iter2 im_out,
+                         const std::complex<R> e)
+    {
+        static_assert(n > 0, "FFT_fixed_split expects n>0");
+        static_assert(n <= fixed_table_limit,
+                      "FFT_fixed_split expects n <= fixed_table_limit");
+        const detail::split_iterator<iter1> in(re_in, im_in);
+        const detail::split_iterator<iter2> out(re_out, im_out);
+        if constexpr (n <= fixed_limit)
+            FFT_Codelet_fixed<n>(in, out, e);
+        else if constexpr (detail::fixed_split(n) > 1)
+            detail::fixed_level<n, 1>(in, out, detail::fixed_powers<n>(e));
+        else
+            FFT_Iterative_fixed<n>(in, out, e);
+    }
+
+    namespace detail
+    {
+        template <class iter, class T, std::size_t... i>
+        constexpr auto fixed_table(std::index_sequence<i...>)
+        {
+            using kernel = void (*)(iter, iter, T);
+            return std::array<kernel, sizeof...(i)>{
+                &FFT_fixed<i + 1, iter, iter, T>...};
+        }
+
+        /*
+            FFT_fixed<n> of [first, last) in place for the run-time size
+            n = last - first <= limit, by a jump table of the kernels
+        */
+        template <std::size_t limit, class iter, class T>
+        void fixed_dispatch(iter first, iter last, const T e)
+        {
+            static constexpr auto table =
+                fixed_table<iter, T>(std::make_index_sequence<limit>{});
+            table[std::distance(first, last) - 1](first, first, e);
+        }
+
+        template <class iter, class R, std::size_t... i>
+        constexpr auto fixed_table_split(std::index_sequence<i...>)
+        {
+            using kernel = void (*)(iter, iter, iter, iter, std::complex<R>);
+            return std::array<kernel, sizeof...(i)>{
+                &FFT_fixed_split<i + 1, iter, iter, R>...};
+        }
+
+        /*
+            FFT_fixed_split<n> of re[0..n), im[0..n) in place for the
+            run-time size n <= limit
+        */
+        template <std::size_t limit, class iter, class R>
+        void fixed_dispatch_split(iter re,
+                                  iter im,
+                                  const int n,
+                                  const std::complex<R> e)
+        {
+            static constexpr auto table =
+                fixed_table_split<iter, R>(std::make_index_sequence<limit>{});
+            table[n - 1](re, im, re, im, e);
+        }
+    }  // namespace detail
+
+    /*
+        FFT of [first, last) in place, for a size n known at run time:
+        a table of FFT_fixed<1..fixed_limit> sends it to the kernel of its
+        size. Throws for n > fixed_limit.
+    */
+    template <class iter, class T>
+    void FFT_fixed(iter first, iter last, const T e)
+    {
+        const auto n = std::distance(first, last);
+        if (n < 1 || n > (long)fixed_limit)
+            throw fftx::error("FFT_fixed: n=" + std::to_string(n) +
+                              " is not in 1.." + std::to_string(fixed_limit));
+        detail::fixed_dispatch<fixed_limit>(first, last, e);
     }
 }  // namespace fftx
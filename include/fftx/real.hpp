@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <fftx/1d.hpp>
+#include <fftx/exception.hpp>
+#include <fftx/math.hpp>
+#include <fftx/plan.hpp>
+
+/*
+    Fourier transforms of real sequences.
+
+    The FT of a real sequence x of size n is Hermitian:
+    X_(n-k) = conj(X_k)
+    only the half spectrum X_0..X_(n/2) is computed or read.
+
+    For even n = 2m the pairs (x_2j, x_2j+1) are packed into the complex
+    sequence z_j = x_2j + i x_2j+1 of size m, whose FT
+    Z_k = E_k + i O_k
+    contains the FTs E and O of the even and odd samples, with
+    E_k = (Z_k + conj(Z_(m-k))) / 2
+    O_k = (Z_k - conj(Z_(m-k))) / 2i
+    X_k = E_k + e^k O_k
+    The cost is one complex FT of size m plus O(n) operations.
+    Odd sizes fall back to a complex FT of size n.
+
+    e must be a complex n-root of unity, eg. exp(-2 pi i/n) for the forward
+    transform and exp(2 pi i/n) for the inverse, which is not normalized.
+*/
+
+namespace fftx
+{
+    /*
+        Precomputed real transform of size n, built on a complex plan of size
+        n/2 (n even) or n (n odd).
+        forward() reads n reals and writes X_0..X_(n/2), inverse() reads
+        X_0..X_(n/2) and writes the n reals. As for plan, the inverse uses
+        e^(n-1) and is not normalized, the memory is allocated by the
+        constructor only and the same real_plan must not be executed by two
+        threads at the same time.
+    */
+    template <class R>
+    class real_plan
+    {
+        using C = std::complex<R>;
+
+        int n, m;
+        plan<C> half;
+        std::vector<C> W;   // W[k] = e^k, k <= m
+        std::vector<C> Wi;  // Wi[k] = e^-k = conj(e^k), k <= m
+        std::vector<C> work;
+
+       public:
+        real_plan(int n_, const C e)
+            : n{n_},
+              m{n_ / 2},
+              half(n_ % 2 || n_ < 1 ? n_ : n_ / 2, n_ % 2 ? e : e * e)
+        {
+            work.resize(n % 2 ? n : m);
+            if (n % 2)
+                return;
+            W = root_powers(e, n, m + 1);
+            for (auto& w : W)
+                Wi.push_back(std::conj(w));
+        }
+
+        int size() const { return n; }
+
+        template <class iter, class citer>
+        void forward(iter first, iter last [[maybe_unused]], citer out)
+        {
+            assert(std::distance(first, last) == n);
+            if (n % 2)
+            {
+                std::copy(first, last, work.begin());
+                half.forward(work.begin(), work.end());
+                std::copy(work.begin(), work.begin() + m + 1, out);
+                return;
+            }
+
+            for (int j = 0; j < m; ++j)
+                out[j] = C(first[2 * j], first[2 * j + 1]);
+            half.forward(out, out + m);
+
+            const C z0 = out[0];
+            out[0] = z0.real() + z0.imag();
+            out[m] = z0.real() - z0.imag();
+
+            // the pair k, m-k is computed from Z_k and Z_(m-k)
+            for (int k = 1, l = m - 1; k <= l; ++k, --l)
+            {
+                const C zk = out[k], zl = std::conj(out[l]);
+                const C E = (zk + zl) * R(0.5);
+                const C O = (zk - zl) * C(0, -0.5);
+                out[k] = E + W[k] * O;
+                out[l] = std::conj(E - W[k] * O);
+            }
+        }
+
+        template <class citer, class iter>
+        void inverse(citer first,
+                     iter out_first,
+                     iter out_last [[maybe_unused]])
+        {
+            assert(std::distance(out_first, out_last) == n);
+            if (n % 2)
+            {
+                for (int k = 0; k <= m; ++k)
+                    work[k] = first[k];
+                for (int k = m + 1; k < n; ++k)
+                    work[k] = std::conj(work[n - k]);
+                half.inverse(work.begin(), work.end());
+                for (int j = 0; j < n; ++j)
+                    out_first[j] = work[j].real();
+                return;
+            }
+
+            // Z_k = E_k + i O_k, up to a factor 2
+            for (int k = 0; k < m; ++k)
+            {
+                const C xk = first[k], xl = std::conj(C(first[m - k]));
+                work[k] = (xk + xl) + C(0, 1) * ((xk - xl) * Wi[k]);
+            }
+            half.inverse(work.begin(), work.end());
+
+            for (int j = 0; j < m; ++j)
+            {
+                out_first[2 * j] = work[j].real();
+                out_first[2 * j + 1] = work[j].imag();
+            }
+        }
+    };
+
+    /*
+        Real to complex transform of [first, last): the n/2+1 elements
+        X_0..X_(n/2) are written to out.
+    */
+    template <class iter, class citer, class R>
+    void FFT_Real(iter first, iter last, citer out, const std::complex<R> e)
+    {
+        const int n = std::distance(first, last);
+        real_plan<R>(n, e).forward(first, last, out);
+    }
+
+    /*
+        Complex to real transform: the half spectrum X_0..X_(n/2) is read
+        from first and the n real elements
+        x_j = sum_k X_k e^(jk), k=0..n-1
+        of the Hermitian sequence X are written to [out_first, out_last).
+    */
+    template <class citer, class iter, class R>
+    void FFT_RealInverse(citer first,
+                         iter out_first,
+                         iter out_last,
+                         const std::complex<R> e)
+    {
+        const int n = std::distance(out_first, out_last);
+        // the inverse of real_plan uses conj(e) = e^-1
+        real_plan<R>(n, std::conj(e)).inverse(first, out_first, out_last);
+    }
+
+    /*
+        Real to complex transform.
+
+        Wrapper
+    */
+    template <class R>
+    std::vector<std::complex<R>> FFT_Real(const std::vector<R>& A,
+                                          const std::complex<R> e)
+    {
+        std::vector<std::complex<R>> B(A.size() / 2 + 1);
+        FFT_Real(A.begin(), A.end(), B.begin(), e);
+        return B;
+    }
+
+    /*
+        Complex to real transform of size n, H is the half spectrum of size
+        n/2+1.
+
+        Wrapper
+    */
+    template <class R>
+    std::vector<R> FFT_RealInverse(const std::vector<std::complex<R>>& H,
+                                   const int n,
+                                   const std::complex<R> e)
+    {
+        if (n < 1 || int(H.size()) != n / 2 + 1)
+            throw fftx::error(std::string(__func__) + " n=" +
+                              std::to_string(n) + " needs n/2+1 elements");
+        std::vector<R> B(n);
+        FFT_RealInverse(H.begin(), B.begin(), B.end(), e);
+        return B;
+    }
+}  // namespace fftx
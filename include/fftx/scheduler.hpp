@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Work-stealing task scheduler for the recursive algorithms.
+
+    Every thread owns a deque of tasks: it pushes the tasks it spawns and
+    pops them from the bottom, so that it runs the most recent, smallest
+    and hottest in cache, first. An idle thread steals from the top of the
+    deque of another thread, where the oldest and largest tasks are, so a
+    few steals are enough to spread a recursion over all the threads.
+
+    A task_group waits for the tasks spawned in it by running other tasks
+    meanwhile, a thread never blocks while some work is available.
+*/
+
+namespace fftx
+{
+    namespace detail
+    {
+        class task_scheduler
+        {
+            using task = std::function<void()>;
+
+            struct task_deque
+            {
+                std::mutex mtx;
+                std::deque<task> tasks;
+            };
+
+            // one deque per worker, the last one for the calling thread
+            std::vector<std::unique_ptr<task_deque>> deques;
+            std::vector<std::thread> workers;
+            std::mutex sleep_mtx, run_mtx;
+            std::condition_variable wake;
+            std::atomic<int> queued{0};
+            bool stop = false;
+
+            // the scheduler of the current thread and the index of its deque
+            struct thread_state
+            {
+                const task_scheduler* owner = nullptr;
+                int index = 0;
+            };
+
+            static thread_state& state()
+            {
+                static thread_local thread_state s;
+                return s;
+            }
+
+            // the deque of the current thread, the last one for the threads
+            // that are not workers
+            int self() const
+            {
+                return state().owner == this ? state().index : size() - 1;
+            }
+
+            bool pop_bottom(int i, task& t)
+            {
+                std::lock_guard<std::mutex> lock(deques[i]->mtx);
+                auto& q = deques[i]->tasks;
+                if (q.empty())
+                    return false;
+                t = std::move(q.back());
+                q.pop_back();
+                return true;
+            }
+
+            bool steal_top(int i, task& t)
+            {
+                std::unique_lock<std::mutex> lock(deques[i]->mtx,
+                                                  std::try_to_lock);
+                auto& q = deques[i]->tasks;
+                if (!lock || q.empty())
+                    return false;
+                t = std::move(q.front());
+                q.pop_front();
+                return true;
+            }
+
+            void loop(int index)
+            {
+                state() = {this, index};
+                for (;;)
+                {
+                    if (run_one())
+                        continue;
+                    std::unique_lock<std::mutex> lock(sleep_mtx);
+                    wake.wait(lock, [&] { return stop || queued > 0; });
+                    if (stop)
+                        return;
+                }
+            }
+
+           public:
+            explicit task_scheduler(int threads)
+            {
+                const int n = std::max(1, threads);
+                for (int i = 0; i < n; ++i)
+                    deques.push_back(std::make_unique<task_deque>());
+                for (int i = 0; i + 1 < n; ++i)
+                    workers.emplace_back([this, i] { loop(i); });
+            }
+
+            ~task_scheduler()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mtx);
+                    stop = true;
+                }
+                wake.notify_all();
+                for (auto& t : workers)
+                    t.join();
+            }
+
+            int size() const { return deques.size(); }
+
+            void push(task t)
+            {
+                const int i = self();
+                {
+                    std::lock_guard<std::mutex> lock(deques[i]->mtx);
+                    deques[i]->tasks.push_back(std::move(t));
+                }
+                ++queued;
+                std::lock_guard<std::mutex> lock(sleep_mtx);
+                wake.notify_one();
+            }
+
+            /*
+                runs one task of the own deque, or stolen from another one,
+                false if none was found
+            */
+            bool run_one()
+            {
+                const int i = self();
+                task t;
+                bool found = pop_bottom(i, t);
+                for (int k = 1; !found && k < size(); ++k)
+                    found = steal_top((i + k) % size(), t);
+                if (!found)
+                    return false;
+                --queued;
+                t();
+                return true;
+            }
+
+            /*
+                f() on the calling thread, which takes part in the tasks
+                that f spawns. The runs of several threads are serialized.
+            */
+            template <class F>
+            void run(F&& f)
+            {
+                if (state().owner == this)
+                    return f();
+                std::lock_guard<std::mutex> lock(run_mtx);
+                const thread_state caller = state();
+                state() = {this, size() - 1};
+                f();
+                state() = caller;
+            }
+
+            /*
+                The scheduler with the given number of threads, created at
+                the first use.
+            */
+            static task_scheduler& instance(int threads)
+            {
+                static std::mutex mtx;
+                static std::map<int, std::unique_ptr<task_scheduler>> all;
+                std::lock_guard<std::mutex> lock(mtx);
+                auto& s = all[threads];
+                if (!s)
+                    s = std::make_unique<task_scheduler>(threads);
+                return *s;
+            }
+        };
+
+        /*
+            Fork-join group of tasks: spawn() pushes a task on the deque of
+            the current thread, wait() returns when all the tasks of the
+            group are done.
+        */
+        class task_group
+        {
+            task_scheduler& scheduler;
+            std::atomic<int> count{0};
+
+           public:
+            explicit task_group(task_scheduler& s) : scheduler{s} {}
+            ~task_group() { wait(); }
+
+            template <class F>
+            void spawn(F f)
+            {
+                ++count;
+                scheduler.push([this, f] {
+                    f();
+                    --count;
+                });
+            }
+
+            void wait()
+            {
+                while (count > 0)
+                    if (!scheduler.run_one())
+                        std::this_thread::yield();
+            }
+        };
+    }  // namespace detail
+}  // namespace fftx
@@ -0,0 +1,521 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#    include <immintrin.h>
+#endif
+
+/*
+    Explicitly vectorized butterflies for std::complex<double> and
+    std::complex<float> stored contiguously.
+
+    simd_pack<T> holds size complex numbers in a register: AVX-512 when the
+    code is compiled with -mavx512f, AVX2 with FMA otherwise. For the other
+    types, or without these instruction sets, size is 1 and the engines
+    keep their generic code.
+
+    ntt_pack holds 16 (AVX-512) or 8 (AVX2) residues of 32 bits for the
+    number-theoretic transforms on the modular integers of modular.hpp.
+*/
+
+namespace fftx
+{
+    namespace detail
+    {
+        template <class T>
+        struct simd_pack
+        {
+            static constexpr int size = 1;
+        };
+
+#if defined(__AVX512F__)
+        template <>
+        struct simd_pack<std::complex<double>>
+        {
+            using reg = __m512d;
+            static constexpr int size = 4;
+
+            static reg load(const std::complex<double>* p)
+            {
+                return _mm512_loadu_pd(reinterpret_cast<const double*>(p));
+            }
+            static void store(std::complex<double>* p, reg a)
+            {
+                _mm512_storeu_pd(reinterpret_cast<double*>(p), a);
+            }
+            // (re, im) -> (im, re)
+            static reg swap(reg a) { return _mm512_shuffle_pd(a, a, 0x55); }
+            static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+            static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+            static reg mul(reg a, reg b)
+            {
+                const reg br = _mm512_shuffle_pd(b, b, 0x00);
+                const reg bi = _mm512_shuffle_pd(b, b, 0xFF);
+                return _mm512_fmaddsub_pd(a, br, _mm512_mul_pd(swap(a), bi));
+            }
+            // i * a and -i * a
+            static reg mul_i(reg a)
+            {
+                const reg s = swap(a);
+                return _mm512_mask_sub_pd(s, 0x55, _mm512_setzero_pd(), s);
+            }
+            static reg mul_minus_i(reg a)
+            {
+                const reg s = swap(a);
+                return _mm512_mask_sub_pd(s, 0xAA, _mm512_setzero_pd(), s);
+            }
+        };
+
+        template <>
+        struct simd_pack<std::complex<float>>
+        {
+            using reg = __m512;
+            static constexpr int size = 8;
+
+            static reg load(const std::complex<float>* p)
+            {
+                return _mm512_loadu_ps(reinterpret_cast<const float*>(p));
+            }
+            static void store(std::complex<float>* p, reg a)
+            {
+                _mm512_storeu_ps(reinterpret_cast<float*>(p), a);
+            }
+            static reg swap(reg a) { return _mm512_shuffle_ps(a, a, 0xB1); }
+            static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+            static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+            static reg mul(reg a, reg b)
+            {
+                const reg br = _mm512_shuffle_ps(b, b, 0xA0);
+                const reg bi = _mm512_shuffle_ps(b, b, 0xF5);
+                return _mm512_fmaddsub_ps(a, br, _mm512_mul_ps(swap(a), bi));
+            }
+            static reg mul_i(reg a)
+            {
+                const reg s = swap(a);
+                return _mm512_mask_sub_ps(s, 0x5555, _mm512_setzero_ps(), s);
+            }
+            static reg mul_minus_i(reg a)
+            {
+                const reg s = swap(a);
+                return _mm512_mask_sub_ps(s, 0xAAAA, _mm512_setzero_ps(), s);
+            }
+        };
+#elif defined(__AVX2__) && defined(__FMA__)
+        template <>
+        struct simd_pack<std::complex<double>>
+        {
+            using reg = __m256d;
+            static constexpr int size = 2;
+
+            static reg load(const std::complex<double>* p)
+            {
+                return _mm256_loadu_pd(reinterpret_cast<const double*>(p));
+            }
+            static void store(std::complex<double>* p, reg a)
+            {
+                _mm256_storeu_pd(reinterpret_cast<double*>(p), a);
+            }
+            static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+            static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+            static reg mul(reg a, reg b)
+            {
+                const reg br = _mm256_movedup_pd(b);
+                const reg bi = _mm256_permute_pd(b, 0xF);
+                return _mm256_fmaddsub_pd(
+                    a, br, _mm256_mul_pd(_mm256_permute_pd(a, 0x5), bi));
+            }
+            static reg mul_i(reg a)
+            {
+                return _mm256_addsub_pd(_mm256_setzero_pd(),
+                                        _mm256_permute_pd(a, 0x5));
+            }
+            static reg mul_minus_i(reg a)
+            {
+                return _mm256_xor_pd(_mm256_permute_pd(a, 0x5),
+                                     _mm256_set_pd(-0.0, 0.0, -0.0, 0.0));
+            }
+        };
+
+        template <>
+        struct simd_pack<std::complex<float>>
+        {
+            using reg = __m256;
+            static constexpr int size = 4;
+
+            static reg load(const std::complex<float>* p)
+            {
+                return _mm256_loadu_ps(reinterpret_cast<const float*>(p));
+            }
+            static void store(std::complex<float>* p, reg a)
+            {
+                _mm256_storeu_ps(reinterpret_cast<float*>(p), a);
+            }
+            static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+            static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+            static reg mul(reg a, reg b)
+            {
+                const reg br = _mm256_moveldup_ps(b);
+                const reg bi = _mm256_movehdup_ps(b);
+                return _mm256_fmaddsub_ps(
+                    a, br, _mm256_mul_ps(_mm256_permute_ps(a, 0xB1), bi));
+            }
+            static reg mul_i(reg a)
+            {
+                return _mm256_addsub_ps(_mm256_setzero_ps(),
+                                        _mm256_permute_ps(a, 0xB1));
+            }
+            static reg mul_minus_i(reg a)
+            {
+                return _mm256_xor_ps(
+                    _mm256_permute_ps(a, 0xB1),
+                    _mm256_set_ps(-0.f, 0.f, -0.f, 0.f, -0.f, 0.f, -0.f, 0.f));
+            }
+        };
+#endif
+
+        /*
+            Montgomery products of 32-bit residues modulo p < 2^30, see
+            modular.hpp. The factor b of mul comes with bq = b p^-1 mod 2^32,
+            so that m = a b p^-1 is a single low product:
+            a b / 2^32 = hi(a b) - hi(m p) + p, in [0, 2p) for a b < 4 p^2
+            The products of 32 x 32 bits are made on the even lanes, then on
+            the odd lanes shifted down.
+        */
+#if defined(__AVX512F__)
+        struct ntt_pack
+        {
+            using reg = __m512i;
+            static constexpr int size = 16;
+
+            // the zero-masked forms: the unmasked ones of GCC 12 start from
+            // an undefined register and set off -Wmaybe-uninitialized
+            static constexpr __mmask8 all8 = 0xFF;
+            static constexpr __mmask16 all16 = 0xFFFF;
+
+            static reg load(const std::uint32_t* p)
+            {
+                return _mm512_loadu_si512(p);
+            }
+            static void store(std::uint32_t* p, reg a)
+            {
+                _mm512_storeu_si512(p, a);
+            }
+            static reg set1(std::uint32_t a) { return _mm512_set1_epi32(a); }
+            static reg add(reg a, reg b) { return _mm512_add_epi32(a, b); }
+            static reg sub(reg a, reg b) { return _mm512_sub_epi32(a, b); }
+            // a - m if a >= m, as unsigned integers
+            static reg reduce(reg a, reg m)
+            {
+                return _mm512_maskz_min_epu32(all16, a, _mm512_sub_epi32(a, m));
+            }
+            // a[idx[l]]
+            static reg permute(reg idx, reg a)
+            {
+                return _mm512_maskz_permutexvar_epi32(all16, idx, a);
+            }
+            // the lanes of b whose bit is set in mask, of a otherwise
+            static reg blend(unsigned mask, reg a, reg b)
+            {
+                return _mm512_mask_blend_epi32(__mmask16(mask), a, b);
+            }
+            static reg mul32(reg a, reg b)
+            {
+                return _mm512_maskz_mul_epu32(all8, a, b);
+            }
+            static reg hi32(reg a)
+            {
+                return _mm512_maskz_srli_epi64(all8, a, 32);
+            }
+            static reg mul(reg a, reg b, reg bq, reg p)
+            {
+                const reg ab0 = mul32(a, b);
+                const reg ab1 = mul32(hi32(a), hi32(b));
+                const reg m = _mm512_mullo_epi32(a, bq);
+                const reg mp0 = mul32(m, p);
+                const reg mp1 = mul32(hi32(m), p);
+                const reg hi_ab =
+                    _mm512_mask_blend_epi32(0xAAAA, hi32(ab0), ab1);
+                const reg hi_mp =
+                    _mm512_mask_blend_epi32(0xAAAA, hi32(mp0), mp1);
+                return add(sub(hi_ab, hi_mp), p);
+            }
+        };
+#elif defined(__AVX2__)
+        struct ntt_pack
+        {
+            using reg = __m256i;
+            static constexpr int size = 8;
+
+            static reg load(const std::uint32_t* p)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const reg*>(p));
+            }
+            static void store(std::uint32_t* p, reg a)
+            {
+                _mm256_storeu_si256(reinterpret_cast<reg*>(p), a);
+            }
+            static reg set1(std::uint32_t a) { return _mm256_set1_epi32(a); }
+            static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+            static reg sub(reg a, reg b) { return _mm256_sub_epi32(a, b); }
+            static reg reduce(reg a, reg m)
+            {
+                return _mm256_min_epu32(a, _mm256_sub_epi32(a, m));
+            }
+            static reg permute(reg idx, reg a)
+            {
+                return _mm256_permutevar8x32_epi32(a, idx);
+            }
+            static reg blend(unsigned mask, reg a, reg b)
+            {
+                const reg bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+                const reg m = _mm256_cmpeq_epi32(
+                    _mm256_and_si256(_mm256_set1_epi32(mask), bits), bits);
+                return _mm256_blendv_epi8(a, b, m);
+            }
+            static reg mul(reg a, reg b, reg bq, reg p)
+            {
+                const reg ab0 = _mm256_mul_epu32(a, b);
+                const reg ab1 = _mm256_mul_epu32(_mm256_srli_epi64(a, 32),
+                                                 _mm256_srli_epi64(b, 32));
+                const reg m = _mm256_mullo_epi32(a, bq);
+                const reg mp0 = _mm256_mul_epu32(m, p);
+                const reg mp1 = _mm256_mul_epu32(_mm256_srli_epi64(m, 32), p);
+                const reg hi_ab =
+                    _mm256_blend_epi32(_mm256_srli_epi64(ab0, 32), ab1, 0xAA);
+                const reg hi_mp =
+                    _mm256_blend_epi32(_mm256_srli_epi64(mp0, 32), mp1, 0xAA);
+                return add(sub(hi_ab, hi_mp), p);
+            }
+        };
+#else
+        struct ntt_pack
+        {
+            static constexpr int size = 1;
+        };
+#endif
+
+        template <class iter>
+        using value_t = typename std::iterator_traits<iter>::value_type;
+
+        /*
+            true for pointers and the iterators of std::vector, which address
+            contiguous memory
+        */
+        template <class iter>
+        struct is_contiguous
+            : std::integral_constant<
+                  bool,
+                  std::is_pointer<iter>::value ||
+                      std::is_same<
+                          iter,
+                          typename std::vector<value_t<iter>>::iterator>::value>
+        {
+        };
+
+        /*
+            true if the butterflies on the range of iter can be vectorized
+        */
+        template <class iter>
+        struct use_simd
+            : std::integral_constant<bool,
+                                     is_contiguous<iter>::value &&
+                                         (simd_pack<value_t<iter>>::size > 1)>
+        {
+        };
+
+        /*
+            Radix-2 butterflies, for j < h:
+            u[j], v[j] = u[j] + w[j] v[j], u[j] - w[j] v[j]
+        */
+        template <class T>
+        void radix2_butterflies(T* u, T* v, const T* w, const int h)
+        {
+            using P = simd_pack<T>;
+            int j = 0;
+            if constexpr (P::size > 1)
+                for (; j + P::size <= h; j += P::size)
+                {
+                    const auto a = P::load(u + j);
+                    const auto b = P::mul(P::load(v + j), P::load(w + j));
+                    P::store(u + j, P::add(a, b));
+                    P::store(v + j, P::sub(a, b));
+                }
+            for (; j < h; ++j)
+            {
+                const T a = u[j], b = v[j] * w[j];
+                u[j] = a + b;
+                v[j] = a - b;
+            }
+        }
+
+        /*
+            Lazy NTT butterflies on 32-bit residues, for j < h:
+            u[j], v[j] = u[j] + w[j] v[j], u[j] - w[j] v[j] + 2p
+            with u[j] first reduced below 2p, see ntt_dit. wq[j] = w[j] p^-1
+            mod 2^32. The last pass reduces its outputs below p.
+        */
+        template <class P = ntt_pack>
+        void ntt_butterflies(std::uint32_t* u,
+                             std::uint32_t* v,
+                             const std::uint32_t* w,
+                             const std::uint32_t* wq,
+                             const int h,
+                             const std::uint32_t p,
+                             const bool last)
+        {
+            const auto p1 = P::set1(p), p2 = P::set1(2 * p);
+            for (int j = 0; j < h; j += P::size)
+            {
+                const auto a = P::reduce(P::load(u + j), p2);
+                const auto b = P::mul(P::load(v + j), P::load(w + j),
+                                      P::load(wq + j), p1);
+                auto x = P::add(a, b), y = P::add(P::sub(a, b), p2);
+                if (last)
+                {
+                    x = P::reduce(P::reduce(x, p2), p1);
+                    y = P::reduce(P::reduce(y, p2), p1);
+                }
+                P::store(u + j, x);
+                P::store(v + j, y);
+            }
+        }
+
+        /*
+            Lazy NTT butterflies of the decimation in frequency, for j < h:
+            u[j], v[j] = u[j] + v[j], w[j] (u[j] - v[j] + 2p)
+            the inputs and the outputs are below 2p, see ntt_dif.
+        */
+        template <class P = ntt_pack>
+        void ntt_butterflies_dif(std::uint32_t* u,
+                                 std::uint32_t* v,
+                                 const std::uint32_t* w,
+                                 const std::uint32_t* wq,
+                                 const int h,
+                                 const std::uint32_t p)
+        {
+            const auto p1 = P::set1(p), p2 = P::set1(2 * p);
+            for (int j = 0; j < h; j += P::size)
+            {
+                const auto a = P::load(u + j), b = P::load(v + j);
+                P::store(u + j, P::reduce(P::add(a, b), p2));
+                P::store(v + j, P::mul(P::add(P::sub(a, b), p2),
+                                       P::load(w + j), P::load(wq + j), p1));
+            }
+        }
+
+        /*
+            The NTT passes h = 1, 2 .. ntt_pack::size / 2 on [x, x + n), or
+            the same passes of the decimation in frequency in the reverse
+            order, on every register at a time: the lanes of u and v are
+            gathered by permutations and the results blended back.
+        */
+        template <bool dif, class P = ntt_pack>
+        void ntt_register_passes(std::uint32_t* x,
+                                 const int n,
+                                 const std::uint32_t* w,
+                                 const std::uint32_t* wq,
+                                 const std::uint32_t p)
+        {
+            constexpr int L = P::size;
+            constexpr int S = __builtin_ctz(L);
+            // lanes of u and v, twiddles and lanes of v of every pass
+            alignas(64) std::uint32_t u[S][L], v[S][L], t[S][L], tq[S][L];
+            unsigned high[S] = {};
+            for (int s = 0; s < S; ++s)
+            {
+                const int h = 1 << s;
+                for (int l = 0; l < L; ++l)
+                {
+                    const int j = l % h, i = l - l % (2 * h);
+                    u[s][l] = i + j;
+                    v[s][l] = i + j + h;
+                    t[s][l] = w[h + j];
+                    tq[s][l] = wq[h + j];
+                    if (l % (2 * h) >= h)
+                        high[s] |= 1u << l;
+                }
+            }
+            const auto p1 = P::set1(p), p2 = P::set1(2 * p);
+            for (int i = 0; i < n; i += L)
+            {
+                auto r = P::load(x + i);
+                for (int q = 0; q < S; ++q)
+                {
+                    const int s = dif ? S - 1 - q : q;
+                    const auto a = P::permute(P::load(u[s]), r);
+                    const auto b = P::permute(P::load(v[s]), r);
+                    const auto W = P::load(t[s]), WQ = P::load(tq[s]);
+                    if constexpr (dif)
+                        r = P::blend(
+                            high[s], P::reduce(P::add(a, b), p2),
+                            P::mul(P::add(P::sub(a, b), p2), W, WQ, p1));
+                    else
+                    {
+                        const auto c = P::reduce(a, p2);
+                        const auto d = P::mul(b, W, WQ, p1);
+                        r = P::blend(high[s], P::add(c, d),
+                                     P::add(P::sub(c, d), p2));
+                    }
+                }
+                P::store(x + i, r);
+            }
+        }
+
+        /*
+            Radix-4 butterflies of FFT_Radix4, for k < m:
+            a = x0[k], b = x1[k] wb[k], c = x2[k] wc[k], d = x3[k] wb[k] wc[k]
+            x0[k] = (a + b) + (c + d)
+            x1[k] = (a - b) + j (c - d)
+            x2[k] = (a + b) - (c + d)
+            x3[k] = (a - b) - j (c - d)
+            where j = +-i is the 4-root of unity.
+        */
+        template <class T>
+        void radix4_butterflies(T* x0,
+                                T* x1,
+                                T* x2,
+                                T* x3,
+                                const T* wb,
+                                const T* wc,
+                                const int m,
+                                const T j)
+        {
+            using P = simd_pack<T>;
+            const bool pos = j.imag() > 0;
+            int k = 0;
+            if constexpr (P::size > 1)
+                for (; k + P::size <= m; k += P::size)
+                {
+                    const auto Wb = P::load(wb + k), Wc = P::load(wc + k);
+                    const auto a = P::load(x0 + k);
+                    const auto b = P::mul(P::load(x1 + k), Wb);
+                    const auto c = P::mul(P::load(x2 + k), Wc);
+                    const auto d = P::mul(P::load(x3 + k), P::mul(Wb, Wc));
+                    const auto apb = P::add(a, b), amb = P::sub(a, b);
+                    const auto cpd = P::add(c, d), cmd = P::sub(c, d);
+                    const auto jcmd = pos ? P::mul_i(cmd) : P::mul_minus_i(cmd);
+                    P::store(x0 + k, P::add(apb, cpd));
+                    P::store(x1 + k, P::add(amb, jcmd));
+                    P::store(x2 + k, P::sub(apb, cpd));
+                    P::store(x3 + k, P::sub(amb, jcmd));
+                }
+            for (; k < m; ++k)
+            {
+                const T a = x0[k], b = x1[k] * wb[k], c = x2[k] * wc[k],
+                        d = x3[k] * (wb[k] * wc[k]);
+                const T apb = a + b, amb = a - b, cpd = c + d, cmd = c - d;
+                const T jcmd = pos ? T(-cmd.imag(), cmd.real())
+                                   : T(cmd.imag(), -cmd.real());
+                x0[k] = apb + cpd;
+                x1[k] = amb + jcmd;
+                x2[k] = apb - cpd;
+                x3[k] = amb - jcmd;
+            }
+        }
+    }  // namespace detail
+}  // namespace fftx
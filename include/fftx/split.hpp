@@ -0,0 +1,105 @@
+#pragma once
+
+#include <complex>
+#include <iterator>
+#include <vector>
+
+#include <fftx/1d.hpp>
+#include <fftx/primitives.hpp>
+
+/*
+    Split complex storage: the real and imaginary parts of a complex
+    sequence are kept in two separate arrays (structure of arrays), so that
+    the complex products in the butterflies are real operations on
+    contiguous data, without the shuffles of the interleaved layout of
+    std::complex.
+
+    The transforms on split data have the suffix _split and take the two
+    ranges:
+    FFT_Radix4_split(re_first, re_last, im_first, e)
+    FFT_Power2_fixed_split<n>(re_in, im_in, re_out, im_out, e)
+    FFT_Codelet_fixed_split<n>, FFT_fixed_split<n>, same arguments
+    plan<T>::forward_split(re_first, re_last, im_first), inverse_split
+    The plans cover every size and never convert the split data: the
+    powers of two, Bluestein's algorithm and the mixed radix stages have
+    split kernels and twiddles, and the small sizes and the prime radices
+    above 7 read and write the split values in place through a proxy
+    iterator. FFT_InPlace, FFT_Stockham, FFT_SplitRadix,
+    FFT_DivideAndConquer, FFT_Iterative, FFT_Rader and FFT_Bluestein stay
+    interleaved, the plans are the split transform of any size.
+*/
+
+namespace fftx
+{
+    template <class R>
+    struct split_complex
+    {
+        std::vector<R> re, im;
+
+        split_complex() = default;
+        explicit split_complex(std::size_t n) : re(n), im(n) {}
+
+        std::size_t size() const { return re.size(); }
+        std::complex<R> operator[](std::size_t i) const
+        {
+            return {re[i], im[i]};
+        }
+    };
+
+    /*
+        interleaved [first, last) -> split re, im
+    */
+    template <class iter, class riter>
+    void deinterleave(iter first, iter last, riter re, riter im)
+    {
+        const int n = std::distance(first, last);
+        for (int i = 0; i < n; ++i)
+        {
+            re[i] = first[i].real();
+            im[i] = first[i].imag();
+        }
+    }
+
+    /*
+        split [re_first, re_last), im -> interleaved out
+    */
+    template <class riter, class iter>
+    void interleave(riter re_first, riter re_last, riter im, iter out)
+    {
+        using C = typename std::iterator_traits<iter>::value_type;
+        const int n = std::distance(re_first, re_last);
+        for (int i = 0; i < n; ++i)
+            out[i] = C(re_first[i], im[i]);
+    }
+
+    template <class R>
+    split_complex<R> to_split(const std::vector<std::complex<R>>& A)
+    {
+        split_complex<R> S(A.size());
+        deinterleave(A.begin(), A.end(), S.re.begin(), S.im.begin());
+        return S;
+    }
+
+    template <class R>
+    std::vector<std::complex<R>> from_split(const split_complex<R>& S)
+    {
+        std::vector<std::complex<R>> A(S.size());
+        interleave(S.re.begin(), S.re.end(), S.im.begin(), A.begin());
+        return A;
+    }
+
+    /*
+        Radix-4 FFT on split complex data.
+        !!! n must be a power of 2 and e must be and n-root of unity
+
+        Wrapper
+    */
+    template <class R>
+    split_complex<R> FFT_Radix4_split(const split_complex<R>& A,
+                                      const std::complex<R> e)
+    {
+        split_complex<R> B(A);
+        FFT_Radix4_split(B.re.begin(), B.re.end(), B.im.begin(), e);
+        return B;
+    }
+}  // namespace fftx
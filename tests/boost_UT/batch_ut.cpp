@@ -0,0 +1,130 @@
+#define BOOST_TEST_MODULE batch
+#include <boost/test/unit_test.hpp>
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+using cd = std::complex<double>;
+
+const double PI = acos(-1.0);
+
+std::vector<cd> random_vec(std::size_t N)
+{
+    std::default_random_engine gen(123);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<cd> V(N);
+    for (auto& x : V)
+        x = cd(distribution(gen), distribution(gen));
+    return V;
+}
+
+/*
+    the transforms of the batch one by one with FFT_BruteForce
+*/
+std::vector<cd> reference(std::vector<cd> A,
+                          int n,
+                          int count,
+                          int stride,
+                          int distance,
+                          cd e)
+{
+    for (int b = 0; b < count; ++b)
+    {
+        std::vector<cd> x(n);
+        for (int i = 0; i < n; ++i)
+            x[i] = A[b * distance + i * stride];
+        x = FFT_BruteForce(x, e);
+        for (int i = 0; i < n; ++i)
+            A[b * distance + i * stride] = x[i];
+    }
+    return A;
+}
+
+double distance(const std::vector<cd>& A, const std::vector<cd>& B)
+{
+    double diff = 0;
+    for (std::size_t i = 0; i < A.size(); ++i)
+        diff += std::norm(A[i] - B[i]);
+    return A.empty() ? 0 : sqrt(diff) / A.size();
+}
+
+BOOST_AUTO_TEST_CASE(batch_throws)
+{
+    BOOST_CHECK_THROW(batch_plan<double>(0, 1, 1, 1, cd{1}), fftx::error);
+    BOOST_CHECK_THROW(batch_plan<double>(4, -1, 1, 4, cd{1}), fftx::error);
+    BOOST_CHECK_THROW(batch_plan<double>(4, 1, 0, 4, cd{1}), fftx::error);
+}
+
+BOOST_AUTO_TEST_CASE(batch_layouts)
+{
+    for (int n : {1, 2, 3, 8, 12, 64, 210})
+        for (int count : {0, 1, 5, 19})
+        {
+            const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+            const auto A = random_vec(n * count);
+
+            // consecutive and interleaved transforms
+            for (auto [stride, dist] : {std::pair{1, n}, std::pair{count, 1}})
+            {
+                if (stride < 1)
+                    continue;
+                const auto FT_A = reference(A, n, count, stride, dist, e);
+                auto B = A;
+                FFT_Batch(B.begin(), n, count, stride, dist, e);
+                BOOST_CHECK_SMALL(distance(B, FT_A), 1e-10);
+
+                batch_plan<double> P(n, count, stride, dist, e);
+                P.inverse(B.begin());
+                for (auto& x : B)
+                    x /= n;
+                BOOST_CHECK_SMALL(distance(B, A), 1e-10);
+            }
+        }
+}
+
+template <std::size_t n>
+void check_fixed(int count)
+{
+    const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+    const auto A = random_vec(n * count);
+    const auto FT_A = reference(A, n, count, count, 1, e);
+    auto B = A;
+    FFT_Batch_fixed<n>(B.begin(), count, count, 1, e);
+    BOOST_CHECK_SMALL(distance(B, FT_A), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(batch_fixed)
+{
+    for (int count : {1, 7, 33})
+    {
+        check_fixed<2>(count);
+        check_fixed<3>(count);
+        check_fixed<4>(count);
+        check_fixed<6>(count);
+        check_fixed<7>(count);
+        check_fixed<16>(count);
+        check_fixed<64>(count);
+        check_fixed<12>(count);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batch_float)
+{
+    using cf = std::complex<float>;
+    const int n = 32, count = 21;
+    const auto A = random_vec(n * count);
+    const auto FT_A =
+        reference(A, n, count, 1, n, cd(cos(2 * PI / n), -sin(2 * PI / n)));
+    std::vector<cf> B(A.begin(), A.end());
+    FFT_Batch_fixed<n>(B.begin(), count, 1, n,
+                       cf(cos(2 * PI / n), -sin(2 * PI / n)));
+    BOOST_CHECK_SMALL(distance(std::vector<cd>(B.begin(), B.end()), FT_A),
+                      1e-5);
+}
@@ -103,9 +103,21 @@ struct convolution_test_suite : public test_suite
             add(BOOST_TEST_CASE_NAME(
                 std::bind(&test_func_convolution, FFT_InPlace<cd>, A, B),
                 "In place FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_convolution, FFT_Stockham<cd>, A, B),
+                "Stockham FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_convolution, FFT_Radix4<cd>, A, B),
+                "Radix-4 FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_convolution, FFT_SplitRadix<cd>, A, B),
+                "Split-radix FFT, N=" + std::to_string(len)));
             add(BOOST_TEST_CASE_NAME(
                 std::bind(&test_func_convolution, FFT_Iterative<cd>, A, B),
                 "Iterative FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_convolution, FFT_Bluestein<cd>, A, B),
+                "Bluestein FFT, N=" + std::to_string(len)));
         }
         for (size_t len : {10, 100, 1000})
         {
@@ -123,6 +135,9 @@ struct convolution_test_suite : public test_suite
             add(BOOST_TEST_CASE_NAME(
                 std::bind(&test_func_convolution, FFT_Iterative<cd>, A, B),
                 "Iterative FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_convolution, FFT_Bluestein<cd>, A, B),
+                "Bluestein FFT, N=" + std::to_string(len)));
         }
         for (size_t len : {3, 5, 7, 13, 1009})
         {
@@ -140,6 +155,9 @@ struct convolution_test_suite : public test_suite
             add(BOOST_TEST_CASE_NAME(
                 std::bind(&test_func_convolution, FFT_Iterative<cd>, A, B),
                 "Iterative FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_convolution, FFT_Bluestein<cd>, A, B),
+                "Bluestein FFT, N=" + std::to_string(len)));
         }
     }
 };
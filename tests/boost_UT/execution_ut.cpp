@@ -0,0 +1,197 @@
+#define BOOST_TEST_MODULE execution
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+using cd = std::complex<double>;
+
+const double PI = acos(-1.0);
+
+// more threads than the cores of most test machines
+const execution::parallel_policy par4{4};
+
+std::vector<cd> random_vec(std::size_t N)
+{
+    std::default_random_engine gen(123);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<cd> V(N);
+    for (auto& x : V)
+        x = cd(distribution(gen), distribution(gen));
+    return V;
+}
+
+double distance(const std::vector<cd>& A, const std::vector<cd>& B)
+{
+    double diff = 0;
+    for (std::size_t i = 0; i < A.size(); ++i)
+        diff += std::norm(A[i] - B[i]);
+    return sqrt(diff) / A.size();
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_run)
+{
+    fftx::detail::thread_pool pool(3);
+    BOOST_TEST(pool.size() == 3);
+
+    // every chunk exactly once, many times in a row
+    for (int rep = 0; rep < 100; ++rep)
+    {
+        std::vector<std::atomic<int>> calls(17);
+        pool.run(17, [&](int c) { ++calls[c]; });
+        for (auto& c : calls)
+            BOOST_TEST(c == 1);
+    }
+
+    long long sum = 0;
+    std::mutex mtx;
+    fftx::detail::parallel_for(par4, 1000, 1, [&](int first, int last) {
+        long long s = 0;
+        for (int i = first; i < last; ++i)
+            s += i;
+        std::lock_guard<std::mutex> lock(mtx);
+        sum += s;
+    });
+    BOOST_TEST(sum == 999 * 1000 / 2);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_power2)
+{
+    // 2^17 and 2^18 use the parallel COBRA bit reversal
+    for (int n : {1 << 10, 1 << 15, 1 << 17, 1 << 18})
+    {
+        const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+        const auto A = random_vec(n);
+        auto FT_A = A;
+        FFT_Radix4(FT_A.begin(), FT_A.end(), e);
+
+        auto B = A;
+        FFT_Radix4(par4, B.begin(), B.end(), e);
+        BOOST_CHECK_SMALL(distance(B, FT_A), 1e-14);
+
+        // radix-2 passes, the round-off differs from radix-4
+        B = A;
+        FFT_InPlace(par4, B.begin(), B.end(), e);
+        BOOST_CHECK_SMALL(distance(B, FT_A), 1e-10);
+
+        B = A;
+        FFT_Radix4(execution::seq, B.begin(), B.end(), e);
+        BOOST_CHECK_SMALL(distance(B, FT_A), 1e-14);
+
+        plan<cd> P(n, e);
+        B = A;
+        P.forward(execution::par, B.begin(), B.end());
+        BOOST_CHECK_SMALL(distance(B, FT_A), 1e-14);
+        P.inverse(par4, B.begin(), B.end());
+        for (auto& x : B)
+            x /= n;
+        BOOST_CHECK_SMALL(distance(B, A), 1e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_plan)
+{
+    // Bluestein (prime 20011) and mixed radix (3^10) sizes
+    for (int n : {20011, 59049})
+    {
+        const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+        const auto A = random_vec(n);
+        plan<cd> P(n, e);
+
+        auto FT_A = A;
+        P.forward(FT_A.begin(), FT_A.end());
+        auto B = A;
+        P.forward(par4, B.begin(), B.end());
+        BOOST_CHECK_SMALL(distance(B, FT_A), 1e-14);
+    }
+}
+
+// sum of [first, last) by recursive halving, one task per half
+long long task_sum(fftx::detail::task_scheduler& s, int first, int last)
+{
+    if (last - first <= 16)
+    {
+        long long r = 0;
+        for (int i = first; i < last; ++i)
+            r += i;
+        return r;
+    }
+    const int mid = (first + last) / 2;
+    long long a, b;
+    {
+        fftx::detail::task_group g(s);
+        g.spawn([&] { a = task_sum(s, first, mid); });
+        g.spawn([&] { b = task_sum(s, mid, last); });
+    }
+    return a + b;
+}
+
+BOOST_AUTO_TEST_CASE(task_scheduler_fork_join)
+{
+    auto& s = fftx::detail::task_scheduler::instance(4);
+    BOOST_TEST(s.size() == 4);
+    for (int rep = 0; rep < 20; ++rep)
+    {
+        long long sum = 0;
+        s.run([&] { sum = task_sum(s, 0, 100000); });
+        BOOST_TEST(sum == 99999LL * 100000 / 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_divide_and_conquer)
+{
+    // mixed radix, power of 2 and Bluestein sizes
+    for (int n : {100000, 59049, 1 << 15, 20011})
+    {
+        const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+        const auto A = random_vec(n);
+        const auto FT_A = FFT_DivideAndConquer(A, e);
+
+        // the powers of e are not computed in the same order
+        BOOST_CHECK_SMALL(distance(FFT_DivideAndConquer(par4, A, e), FT_A),
+                          1e-10);
+        BOOST_CHECK_SMALL(
+            distance(FFT_DivideAndConquer(execution::seq, A, e), FT_A),
+            1e-14);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_nd)
+{
+    // 3 and 6 threads do not divide N = 32, 40 has no Bluestein rows
+    for (auto pol : {par4, execution::parallel_policy{3},
+                     execution::parallel_policy{6}})
+        for (int N : {32, 40})
+        {
+            const cd e = std::polar(1.0, -2 * PI / N);
+            const auto A = random_vec(N * N * N);
+            auto FT_A = A;
+            FFT_dim<3>(FT_A.begin(), FT_A.end(), N, e);
+
+            auto B = A;
+            FFT_dim<3>(pol, B.begin(), B.end(), N, e);
+            BOOST_TEST((B == FT_A));
+
+            const auto C = random_vec(N * N * N * N);
+            auto FT_C = C;
+            FFT_dim<4>(FT_C.begin(), FT_C.end(), N, e);
+            auto D = C;
+            FFT_dim<4>(pol, D.begin(), D.end(), N, e);
+            BOOST_TEST((D == FT_C));
+        }
+
+    // serial below the threshold
+    const cd e = std::polar(1.0, -2 * PI / 8);
+    std::vector<cd> A = random_vec(64), B = A;
+    FFT_dim<2>(A.begin(), A.end(), 8, e);
+    FFT_dim<2>(par4, B.begin(), B.end(), 8, e);
+    BOOST_TEST((A == B));
+}
@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE fourstep
+#include <boost/test/unit_test.hpp>
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+#include "modulo.h"
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+using cd = std::complex<double>;
+
+const double PI = acos(-1.0);
+
+typedef my_modulo_lib::field_modulo<int, 337> Z337;
+using M_int = my_modulo_lib::mint<Z337>;
+
+std::vector<cd> random_vec(std::size_t N)
+{
+    std::default_random_engine gen(123);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<cd> V(N);
+    for (auto& x : V)
+        x = cd(distribution(gen), distribution(gen));
+    return V;
+}
+
+double distance(const std::vector<cd>& A, const std::vector<cd>& B)
+{
+    double diff = 0;
+    for (std::size_t i = 0; i < A.size(); ++i)
+        diff += std::norm(A[i] - B[i]);
+    return sqrt(diff) / A.size();
+}
+
+BOOST_AUTO_TEST_CASE(transpose)
+{
+    for (auto [rows, cols] : {std::pair{1, 1}, {3, 70}, {64, 64}, {45, 33}})
+    {
+        std::vector<int> A(rows * cols), B(rows * cols);
+        for (int i = 0; i < rows * cols; ++i)
+            A[i] = i;
+        fftx::detail::transpose(A.begin(), B.begin(), rows, cols);
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < cols; ++c)
+                BOOST_TEST(B[c * rows + r] == A[r * cols + c]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(four_step)
+{
+    // powers of two, square and rectangular matrices, mixed radices and a
+    // prime size given to a single plan
+    for (int n : {1, 2, 16, 128, 1024, 1 << 16, 1 << 17, 1000, 4095, 10007})
+    {
+        const cd e = std::polar(1.0, -2 * PI / n);
+        const auto A = random_vec(n);
+        auto FT_A = A;
+        plan<cd>(n, e).forward(FT_A.begin(), FT_A.end());
+
+        BOOST_CHECK_SMALL(distance(FFT_FourStep(A, e), FT_A), 1e-10);
+        BOOST_CHECK_SMALL(distance(FFT_SixStep(A, e), FT_A), 1e-10);
+
+        // inverse
+        for (bool six_step : {false, true})
+        {
+            four_step_plan<cd> P(n, e, six_step);
+            auto B = FT_A;
+            P.inverse(B.begin(), B.end());
+            for (auto& x : B)
+                x /= double(n);
+            BOOST_CHECK_SMALL(distance(B, A), 1e-10);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(four_step_modular)
+{
+    // 10 is a primitive root of unity modulo 337
+    const M_int g{10};
+    for (int n : {2, 3, 8, 16, 21, 48, 336})
+    {
+        const M_int e = power(g, 336 / n);
+        std::vector<M_int> A;
+        for (int i = 0; i < n; ++i)
+            A.emplace_back(i * i + 1);
+        const auto FT_A = FFT_BruteForce(A, e);
+        BOOST_TEST((FFT_FourStep(A, e) == FT_A));
+        BOOST_TEST((FFT_SixStep(A, e) == FT_A));
+
+        four_step_plan<M_int> P(n, e);
+        auto B = FT_A;
+        const M_int inv_n{M_int{n}.inverse()};
+        P.inverse(B.begin(), B.end());
+        for (auto& x : B)
+            x *= inv_n;
+        BOOST_TEST((B == A));
+    }
+}
@@ -80,9 +80,21 @@ struct inverse_test_suite : public test_suite
             add(BOOST_TEST_CASE_NAME(
                 std::bind(&test_func_inverse, FFT_InPlace<cd>, A),
                 "In place FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_inverse, FFT_Stockham<cd>, A),
+                "Stockham FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_inverse, FFT_Radix4<cd>, A),
+                "Radix-4 FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_inverse, FFT_SplitRadix<cd>, A),
+                "Split-radix FFT, N=" + std::to_string(len)));
             add(BOOST_TEST_CASE_NAME(
                 std::bind(&test_func_inverse, FFT_Iterative<cd>, A),
                 "Iterative FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_inverse, FFT_Bluestein<cd>, A),
+                "Bluestein FFT, N=" + std::to_string(len)));
         }
         for (size_t len : {10, 100, 1000})
         {
@@ -103,6 +115,9 @@ struct inverse_test_suite : public test_suite
             add(BOOST_TEST_CASE_NAME(
                 std::bind(&test_func_inverse, FFT_Iterative<cd>, A),
                 "Iterative FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_inverse, FFT_Bluestein<cd>, A),
+                "Bluestein FFT, N=" + std::to_string(len)));
         }
         for (size_t len : {3, 5, 7, 13, 1009})
         {
@@ -123,6 +138,12 @@ struct inverse_test_suite : public test_suite
             add(BOOST_TEST_CASE_NAME(
                 std::bind(&test_func_inverse, FFT_Iterative<cd>, A),
                 "Iterative FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_inverse, FFT_Bluestein<cd>, A),
+                "Bluestein FFT, N=" + std::to_string(len)));
+            add(BOOST_TEST_CASE_NAME(
+                std::bind(&test_func_inverse, FFT_Rader<cd>, A),
+                "Rader FFT, N=" + std::to_string(len)));
         }
     }
 };
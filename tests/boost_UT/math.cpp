@@ -1,7 +1,11 @@
 #define BOOST_TEST_MODULE math
 #include <boost/test/unit_test.hpp>
 
+#include <numeric>
+#include <vector>
+
 #include <fftx/math.hpp>
+#include <fftx/permutation.hpp>
 
 using namespace boost::unit_test;
 using namespace boost;
@@ -29,3 +33,52 @@ BOOST_AUTO_TEST_CASE(power_test)
     BOOST_TEST(power(2, 6) == 64);
     BOOST_TEST(power(3, 6) == 729);
 }
+
+BOOST_AUTO_TEST_CASE(primitive_root_test)
+{
+    BOOST_TEST(primitive_root(2) == 1);
+    BOOST_TEST(primitive_root(3) == 2);
+    BOOST_TEST(primitive_root(7) == 3);
+    BOOST_TEST(primitive_root(337) == 10);
+
+    // g^k != 1 for 0 < k < p-1
+    for (int p : {5, 13, 1009, 12109})
+    {
+        const int g = primitive_root(p);
+        long long x = 1;
+        for (int k = 1; k < p - 1; ++k)
+        {
+            x = x * g % p;
+            BOOST_TEST(x != 1);
+        }
+        BOOST_TEST(x * g % p == 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bit_reverse_test)
+{
+    BOOST_TEST(bit_reverse(1, 3) == 4);
+    BOOST_TEST(bit_reverse(6, 3) == 3);
+    BOOST_TEST(bit_reverse(5, 4) == 10);
+
+    for (int nbits = 0; nbits <= 18; ++nbits)
+    {
+        const int n = 1 << nbits;
+        std::vector<int> A(n), B(n), C(n);
+        for (int i = 0; i < n; ++i)
+            A[bit_reverse(i, nbits)] = B[i] = C[i] = i;
+
+        bit_reverse_permutation(B.begin(), B.end());
+        BOOST_TEST(A == B);
+
+        bit_reverse_incremental(C.begin(), C.end());
+        BOOST_TEST(A == C);
+
+        if (n >= 1 << 10)
+        {
+            std::iota(C.begin(), C.end(), 0);
+            bit_reverse_cobra<5>(C.begin(), C.end());
+            BOOST_TEST(A == C);
+        }
+    }
+}
@@ -0,0 +1,229 @@
+#define BOOST_TEST_MODULE nd
+#include <boost/test/unit_test.hpp>
+
+#include <complex>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+using cd = std::complex<double>;
+
+const double PI = acos(-1.0);
+
+std::vector<cd> random_vec(std::size_t N)
+{
+    std::default_random_engine gen(123);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<cd> V(N);
+    for (auto& x : V)
+        x = cd(distribution(gen), distribution(gen));
+    return V;
+}
+
+double distance(const std::vector<cd>& A, const std::vector<cd>& B)
+{
+    double diff = 0;
+    for (std::size_t i = 0; i < A.size(); ++i)
+        diff += std::norm(A[i] - B[i]);
+    return sqrt(diff) / A.size();
+}
+
+/*
+    FFT_BruteForce along every axis of the N^dim row-major array A
+*/
+std::vector<cd> reference(std::vector<cd> A, int N, int dim, cd e)
+{
+    const int n = A.size();
+    for (int d = 0, stride = 1; d < dim; ++d, stride *= N)
+        for (int i = 0; i < n; ++i)
+        {
+            // i is the first element of a line along the axis
+            if ((i / stride) % N != 0)
+                continue;
+            std::vector<cd> x(N);
+            for (int k = 0; k < N; ++k)
+                x[k] = A[i + k * stride];
+            x = FFT_BruteForce(x, e);
+            for (int k = 0; k < N; ++k)
+                A[i + k * stride] = x[k];
+        }
+    return A;
+}
+
+/*
+    FFT_BruteForce along the given axes of the row-major array A
+*/
+std::vector<cd> reference(std::vector<cd> A,
+                          const std::vector<int>& shape,
+                          const std::vector<int>& axes,
+                          const std::vector<cd>& roots)
+{
+    const int n = A.size();
+    const auto strides = row_major_strides(shape);
+    for (std::size_t i = 0; i < axes.size(); ++i)
+    {
+        const int N = shape[axes[i]], stride = strides[axes[i]];
+        for (int j = 0; j < n; ++j)
+        {
+            if ((j / stride) % N != 0)
+                continue;
+            std::vector<cd> x(N);
+            for (int k = 0; k < N; ++k)
+                x[k] = A[j + k * stride];
+            x = FFT_BruteForce(x, roots[i]);
+            for (int k = 0; k < N; ++k)
+                A[j + k * stride] = x[k];
+        }
+    }
+    return A;
+}
+
+std::vector<cd> roots_of(const std::vector<int>& shape,
+                         const std::vector<int>& axes)
+{
+    std::vector<cd> roots;
+    for (int a : axes)
+        roots.push_back(std::polar(1.0, -2 * PI / shape[a]));
+    return roots;
+}
+
+BOOST_AUTO_TEST_CASE(nd_throws)
+{
+    std::vector<cd> A(10);
+    BOOST_CHECK_THROW(FFT_dim<2>(A.begin(), A.end(), 3, cd{1}), fftx::error);
+
+    const std::vector<int> shape{2, 5};
+    const auto strides = row_major_strides(shape);
+    BOOST_CHECK_THROW(nd_plan<cd>(shape, strides, {2}, {cd{1}}), fftx::error);
+    BOOST_CHECK_THROW(nd_plan<cd>(shape, strides, {0, 0}, {cd{1}, cd{1}}),
+                      fftx::error);
+    BOOST_CHECK_THROW(nd_plan<cd>(shape, strides, {0}, {}), fftx::error);
+    BOOST_CHECK_THROW(nd_plan<cd>({2, 0}, strides, {0}, {cd{1}}),
+                      fftx::error);
+}
+
+BOOST_AUTO_TEST_CASE(nd_transform)
+{
+    for (int N : {1, 2, 3, 8, 12, 17, 40})
+    {
+        const cd e = std::polar(1.0, -2 * PI / N);
+
+        auto A = random_vec(N);
+        auto B = A;
+        FFT_dim<1>(B.begin(), B.end(), N, e);
+        BOOST_CHECK_SMALL(distance(B, reference(A, N, 1, e)), 1e-10);
+
+        A = random_vec(N * N);
+        B = A;
+        FFT_dim<2>(B.begin(), B.end(), N, e);
+        BOOST_CHECK_SMALL(distance(B, reference(A, N, 2, e)), 1e-10);
+
+        if (N > 17)
+            continue;
+        A = random_vec(N * N * N);
+        B = A;
+        FFT_dim<3>(B.begin(), B.end(), N, e);
+        BOOST_CHECK_SMALL(distance(B, reference(A, N, 3, e)), 1e-10);
+
+        A = random_vec(N * N * N * N);
+        B = A;
+        FFT_dim<4>(B.begin(), B.end(), N, e);
+        BOOST_CHECK_SMALL(distance(B, reference(A, N, 4, e)), 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(nd_shapes)
+{
+    // the last one has an axis of 64 lines that span more than
+    // strided_threshold elements, transformed by blocks
+    for (std::vector<int> shape : {std::vector<int>{7},
+                                   {5, 6},
+                                   {6, 1, 35},
+                                   {5, 6, 7},
+                                   {3, 4, 5, 2},
+                                   {64, 24, 32}})
+    {
+        const int n = std::accumulate(shape.begin(), shape.end(), 1,
+                                      std::multiplies<int>());
+        std::vector<int> axes(shape.size());
+        std::iota(axes.begin(), axes.end(), 0);
+        const auto roots = roots_of(shape, axes);
+        const auto A = random_vec(n);
+        const auto FT_A = reference(A, shape, axes, roots);
+
+        auto B = A;
+        FFT_nd(B.begin(), shape, roots);
+        BOOST_CHECK_SMALL(distance(B, FT_A), 1e-10);
+
+        // the same array in column-major order, with the axes reversed
+        std::vector<int> rshape(shape.rbegin(), shape.rend());
+        std::vector<cd> rroots(roots.rbegin(), roots.rend());
+        B = A;
+        FFT_nd(B.begin(), rshape, column_major_strides(rshape), axes, rroots);
+        BOOST_CHECK_SMALL(distance(B, FT_A), 1e-10);
+
+        // inverse
+        nd_plan<cd> P(shape, row_major_strides(shape), axes, roots);
+        P.inverse(B.begin());
+        for (auto& x : B)
+            x /= double(n);
+        BOOST_CHECK_SMALL(distance(B, A), 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(nd_sub_block)
+{
+    // the 4 x 5 x 6 block at (2, 3, 1) of a 10 x 12 x 9 array, along the
+    // axes 0 and 2 only
+    const std::vector<int> big{10, 12, 9}, shape{4, 5, 6}, axes{2, 0};
+    const auto strides = row_major_strides(big);
+    const long long origin = 2 * strides[0] + 3 * strides[1] + 1;
+    const auto roots = roots_of(shape, axes);
+
+    const auto A = random_vec(10 * 12 * 9);
+    auto B = A;
+    FFT_nd(B.begin() + origin, shape, strides, axes, roots);
+
+    std::vector<cd> block;
+    std::vector<bool> inside(A.size());
+    for (int i = 0; i < shape[0]; ++i)
+        for (int j = 0; j < shape[1]; ++j)
+            for (int k = 0; k < shape[2]; ++k)
+            {
+                const long long p =
+                    origin + i * strides[0] + j * strides[1] + k;
+                block.push_back(A[p]);
+                inside[p] = true;
+            }
+    const auto FT_block = reference(block, shape, axes, roots);
+
+    int q = 0;
+    double diff = 0;
+    for (std::size_t p = 0; p < A.size(); ++p)
+        if (inside[p])
+            diff += std::norm(B[p] - FT_block[q++]);
+        else
+            BOOST_TEST((B[p] == A[p]));
+    BOOST_CHECK_SMALL(sqrt(diff) / q, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(nd_strided_iterator)
+{
+    std::vector<int> A(20);
+    std::iota(A.begin(), A.end(), 0);
+    strided_iterator<std::vector<int>::iterator> first(A.begin() + 18, -3);
+    const auto last = first + 7;
+    BOOST_TEST(std::distance(first, last) == 7);
+    BOOST_TEST(first[2] == 12);
+    BOOST_TEST(*(last - 1) == 0);
+    std::reverse(first, last);
+    BOOST_TEST(A[18] == 0);
+    BOOST_TEST(A[0] == 18);
+}
@@ -0,0 +1,191 @@
+#define BOOST_TEST_MODULE ntt
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+#include "modulo.h"
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+// 119 2^23 + 1 and 29 2^57 + 1
+using M32 = mod32<998244353>;
+using M64 = mod64<4179340454199820289ULL>;
+
+using mint = my_modulo_lib::mint<
+    my_modulo_lib::field_modulo<long long, 998244353>>;
+
+template <class M>
+std::vector<M> random_vec(std::size_t N)
+{
+    std::mt19937_64 gen(123);
+    std::vector<M> V(N);
+    for (auto& x : V)
+        x = M(gen() % M::modulus);
+    return V;
+}
+
+template <class M>
+void test_arithmetic()
+{
+    using U = typename M::integer;
+    __extension__ typedef unsigned __int128 u128;
+    const U p = M::modulus;
+    std::mt19937_64 gen(7);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const U a = gen() % p, b = gen() % p;
+        BOOST_TEST(M(a).value() == a);
+        BOOST_TEST((M(a) + M(b)).value() == U((u128(a) + b) % p));
+        BOOST_TEST((M(a) - M(b)).value() == U((u128(a) + p - b) % p));
+        BOOST_TEST((M(a) * M(b)).value() == U(u128(a) * b % p));
+        if (a)
+            BOOST_TEST((M(a) * M(a).inverse()).value() == 1u);
+    }
+    BOOST_TEST(M(-1).value() == p - 1);
+    BOOST_TEST(M(-(long long)p - 3).value() == p - 3);
+    BOOST_TEST((-M(5)).value() == p - 5);
+    BOOST_TEST(M(p + 2).value() == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic)
+{
+    test_arithmetic<M32>();
+    test_arithmetic<M64>();
+    test_arithmetic<mod32<7>>();
+}
+
+BOOST_AUTO_TEST_CASE(roots_of_unity)
+{
+    for (int n : {1, 2, 1 << 10, 1 << 23, 7 * 17})
+    {
+        const M32 e = M32::root_of_unity(n);
+        BOOST_TEST(e.pow(n) == M32(1));
+        if (n > 1)
+            BOOST_TEST(e.pow(n / 2) != M32(1));
+    }
+    BOOST_TEST(M64::root_of_unity(1ULL << 57).pow(1ULL << 56) == M64(-1));
+    BOOST_CHECK_THROW(M32::root_of_unity(1 << 24), fftx::error);
+    BOOST_CHECK_THROW(M32::root_of_unity(0), fftx::error);
+}
+
+template <class M>
+void test_in_place(int n)
+{
+    const M e = M::root_of_unity(n);
+    const auto A = random_vec<M>(n);
+    const auto B = FFT_BruteForce(A, e);
+    BOOST_CHECK(FFT_InPlace(A, e) == B);
+
+    ntt_plan<M> P(n);
+    auto C = A;
+    P.forward(C.begin(), C.end());
+    BOOST_CHECK(C == B);
+    P.inverse(C.begin(), C.end());
+    const M n_inv = M(n).inverse();
+    for (auto& c : C)
+        c *= n_inv;
+    BOOST_CHECK(C == A);
+}
+
+BOOST_AUTO_TEST_CASE(in_place)
+{
+    for (int n = 1; n <= 1 << 11; n *= 2)
+    {
+        test_in_place<M32>(n);
+        test_in_place<M64>(n);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(against_mint)
+{
+    // the lazy butterflies agree with the generic ones on mint, within
+    // the cache blocks and across them
+    for (int n : {1 << 4, 1 << 13, 1 << 19})
+    {
+        const auto A = random_vec<M32>(n);
+        const M32 e = M32::root_of_unity(n);
+        std::vector<mint> B(n);
+        for (int i = 0; i < n; ++i)
+            B[i] = mint((long long)A[i].value());
+        const auto FT_A = FFT_InPlace(A, e);
+        const auto FT_B = FFT_InPlace(B, mint((long long)e.value()));
+        for (int i = 0; i < n; ++i)
+            BOOST_TEST((long long)FT_B[i] == (long long)FT_A[i].value());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bit_reversed)
+{
+    // forward_bit_reversed then inverse_bit_reversed is n times the identity
+    for (int n = 1; n <= 1 << 13; n *= 2)
+    {
+        const auto A = random_vec<M32>(n);
+        const M32 e = M32::root_of_unity(n);
+        ntt_plan<M32> P(n, e);
+        auto B = A, C = A;
+        P.forward(B.begin(), B.end());
+        P.forward_bit_reversed(C.begin(), C.end());
+        bit_reverse_permutation(C.begin(), C.end());
+        for (auto& c : C)  // reduces the values below p
+            c *= M32(1);
+        BOOST_CHECK(C == B);
+        bit_reverse_permutation(C.begin(), C.end());
+        P.inverse_bit_reversed(C.begin(), C.end());
+        const M32 n_inv = M32(n).inverse();
+        for (auto& c : C)
+            c *= n_inv;
+        BOOST_CHECK(C == A);
+    }
+}
+
+template <class R, class I>
+std::vector<R> naive_product(const std::vector<I>& a, const std::vector<I>& b)
+{
+    std::vector<R> c(a.size() + b.size() - 1, R(0));
+    for (std::size_t i = 0; i < a.size(); ++i)
+        for (std::size_t j = 0; j < b.size(); ++j)
+            c[i + j] += R(a[i]) * R(b[j]);
+    return c;
+}
+
+template <class I>
+std::vector<I> random_integers(std::size_t N, I lo, I hi)
+{
+    std::mt19937_64 gen(N);
+    std::uniform_int_distribution<I> U(lo, hi);
+    std::vector<I> V(N);
+    for (auto& x : V)
+        x = U(gen);
+    return V;
+}
+
+BOOST_AUTO_TEST_CASE(integer_convolutions)
+{
+    __extension__ typedef __int128 i128;
+    for (int n : {1, 3, 100, 1000})
+    {
+        const auto a = random_integers<int>(n, -(1 << 20), 1 << 20);
+        const auto b = random_integers<int>(n / 2 + 1, -(1 << 20), 1 << 20);
+        const auto c = naive_product<long long>(a, b);
+        BOOST_CHECK(integer_convolution(a, b) == c);
+        BOOST_CHECK(integer_convolution(execution::par, a, b) == c);
+
+        const auto A = random_integers<long long>(n, -(1LL << 55), 1LL << 55);
+        const auto B = random_integers<long long>(n, 0, 1LL << 60);
+        BOOST_CHECK((integer_convolution<i128>(A, B) ==
+                     naive_product<i128>(A, B)));
+    }
+    const std::vector<unsigned> u{1, 2, 3};
+    BOOST_CHECK((integer_convolution<int>(u, u) ==
+                 std::vector<int>{1, 4, 10, 12, 9}));
+    BOOST_CHECK(integer_convolution(std::vector<unsigned>{}, u).empty());
+
+    const std::vector<long long> big(2, 1LL << 62);
+    BOOST_CHECK_THROW(integer_convolution(big, big), fftx::error);
+}
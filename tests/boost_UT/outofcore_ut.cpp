@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE outofcore
+#include <boost/test/unit_test.hpp>
+
+#include <complex>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+#include "modulo.h"
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+using cd = std::complex<double>;
+
+const double PI = acos(-1.0);
+
+typedef my_modulo_lib::field_modulo<int, 337> Z337;
+using M_int = my_modulo_lib::mint<Z337>;
+
+std::vector<cd> random_vec(std::size_t N)
+{
+    std::default_random_engine gen(123);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<cd> V(N);
+    for (auto& x : V)
+        x = cd(distribution(gen), distribution(gen));
+    return V;
+}
+
+double distance(const std::vector<cd>& A, const std::vector<cd>& B)
+{
+    double diff = 0;
+    for (std::size_t i = 0; i < A.size(); ++i)
+        diff += std::norm(A[i] - B[i]);
+    return sqrt(diff) / A.size();
+}
+
+// memory for 4 slabs of the given number of values
+template <class T>
+std::size_t slabs(std::size_t values)
+{
+    return 4 * values * sizeof(T);
+}
+
+BOOST_AUTO_TEST_CASE(out_of_core_region)
+{
+    // several slabs per pass, with partial last slabs for 1155 = 33 * 35
+    for (auto [n, slab] : {std::pair{1, 1}, {4096, 256}, {4096, 4096},
+                           {1155, 100}, {1 << 16, 1000}, {10007, 10007}})
+    {
+        const cd e = std::polar(1.0, -2 * PI / n);
+        const auto A = random_vec(n);
+        auto FT_A = A;
+        plan<cd>(n, e).forward(FT_A.begin(), FT_A.end());
+
+        std::vector<cd> B(n);
+        FFT_OutOfCore(A.begin(), A.end(), B.begin(), e, slabs<cd>(slab));
+        BOOST_CHECK_SMALL(distance(B, FT_A), 1e-10);
+    }
+
+    const auto A = random_vec(1 << 12);
+    std::vector<cd> B(A.size());
+    BOOST_CHECK_THROW(FFT_OutOfCore(A.begin(), A.end(), B.begin(), cd{1},
+                                    slabs<cd>(32)),
+                      fftx::error);
+}
+
+BOOST_AUTO_TEST_CASE(out_of_core_modular)
+{
+    // 10 is a primitive root of unity modulo 337
+    const M_int g{10};
+    for (int n : {2, 16, 21, 48, 336})
+    {
+        const M_int e = power(g, 336 / n);
+        std::vector<M_int> A;
+        for (int i = 0; i < n; ++i)
+            A.emplace_back(i * i + 1);
+        std::vector<M_int> B(n);
+        FFT_OutOfCore(A.begin(), A.end(), B.begin(), e, slabs<M_int>(24));
+        BOOST_TEST((B == FFT_BruteForce(A, e)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(out_of_core_file)
+{
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string input = dir / "fftx_outofcore_in.bin";
+    const std::string output = dir / "fftx_outofcore_out.bin";
+
+    const int n = 3 << 12;
+    const cd e = std::polar(1.0, -2 * PI / n);
+    const auto A = random_vec(n);
+    std::ofstream(input, std::ios::binary)
+        .write(reinterpret_cast<const char*>(A.data()), n * sizeof(cd));
+
+    FFT_OutOfCore(input, output, e, slabs<cd>(1000));
+    BOOST_TEST(std::filesystem::file_size(output) == n * sizeof(cd));
+    std::vector<cd> B(n);
+    std::ifstream(output, std::ios::binary)
+        .read(reinterpret_cast<char*>(B.data()), n * sizeof(cd));
+    auto FT_A = A;
+    plan<cd>(n, e).forward(FT_A.begin(), FT_A.end());
+    BOOST_CHECK_SMALL(distance(B, FT_A), 1e-10);
+
+    BOOST_CHECK_THROW(FFT_OutOfCore(input, input, e), fftx::error);
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
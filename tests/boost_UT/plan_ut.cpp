@@ -0,0 +1,163 @@
+#define BOOST_TEST_MODULE plan
+#include <boost/test/unit_test.hpp>
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+#include "modulo.h"
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+using cd = std::complex<double>;
+
+const double PI = acos(-1.0);
+
+typedef my_modulo_lib::field_modulo<int, 337> Z337;
+using M_int = my_modulo_lib::mint<Z337>;
+
+// 12109 = 12 * 1009 + 1
+typedef my_modulo_lib::field_modulo<long long, 12109> Z12109;
+using M_ll = my_modulo_lib::mint<Z12109>;
+
+std::vector<cd> random_vec(std::size_t N)
+{
+    std::default_random_engine gen(123);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<cd> V(N);
+    for (auto& x : V)
+        x = cd(distribution(gen), distribution(gen));
+    return V;
+}
+
+// DFT with the exact phase of every term, as a reference
+std::vector<cd> reference_dft(const std::vector<cd>& A)
+{
+    const long long n = A.size();
+    std::vector<cd> B(n);
+    for (long long k = 0; k < n; ++k)
+        for (long long j = 0; j < n; ++j)
+            B[k] += A[j] * std::polar(1.0, -2 * PI * (j * k % n) / n);
+    return B;
+}
+
+double distance(const std::vector<cd>& A, const std::vector<cd>& B)
+{
+    double diff = 0;
+    for (std::size_t i = 0; i < A.size(); ++i)
+        diff += std::norm(A[i] - B[i]);
+    return sqrt(diff) / A.size();
+}
+
+BOOST_AUTO_TEST_CASE(plan_throws)
+{
+    BOOST_CHECK_THROW(plan<cd>(0, cd{1}), fftx::error);
+}
+
+BOOST_AUTO_TEST_CASE(plan_complex)
+{
+    for (int n :
+         {1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 60, 128, 210, 1009, 1024, 2018})
+    {
+        const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+        const auto A = random_vec(n);
+        const auto FT_A = reference_dft(A);
+
+        plan<cd> P(n, e);
+        BOOST_TEST(P.size() == n);
+
+        // the same plan is executed many times
+        for (int rep = 0; rep < 3; ++rep)
+        {
+            auto B = A;
+            P.forward(B.begin(), B.end());
+            BOOST_CHECK_SMALL(distance(B, FT_A), 1e-10);
+
+            P.inverse(B.begin(), B.end());
+            for (auto& x : B)
+                x /= n;
+            BOOST_CHECK_SMALL(distance(B, A), 1e-10);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(plan_float)
+{
+    // single precision, vectorized butterflies
+    using cf = std::complex<float>;
+    for (int n : {2, 4, 8, 32, 64, 512, 2048})
+    {
+        const auto A = random_vec(n);
+        const auto FT_A = reference_dft(A);
+        std::vector<cf> B(A.begin(), A.end());
+
+        plan<cf> P(n, cf(cos(2 * PI / n), -sin(2 * PI / n)));
+        P.forward(B.begin(), B.end());
+        BOOST_CHECK_SMALL(
+            distance(std::vector<cd>(B.begin(), B.end()), FT_A), 1e-4);
+
+        FFT_InPlace(B.begin(), B.end(), cf(cos(2 * PI / n), sin(2 * PI / n)));
+        for (int i = 0; i < n; ++i)
+            B[i] /= n;
+        BOOST_CHECK_SMALL(distance(std::vector<cd>(B.begin(), B.end()), A),
+                          1e-4);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(plan_modular)
+{
+    // 10 is a primitive root of unity modulo 337
+    const M_int g{10};
+    for (int n : {2, 3, 7, 8, 16, 21, 48, 336})
+    {
+        const M_int e = power(g, 336 / n);
+        std::vector<M_int> A;
+        for (int i = 0; i < n; ++i)
+            A.emplace_back(i * i + 1);
+        const auto FT_A = FFT_BruteForce(A, e);
+
+        plan<M_int> P(n, e);
+        auto B = A;
+        P.forward(B.begin(), B.end());
+        BOOST_TEST((B == FT_A));
+
+        const M_int inv_n{M_int{n}.inverse()};
+        P.inverse(B.begin(), B.end());
+        for (auto& x : B)
+            x *= inv_n;
+        BOOST_TEST((B == A));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(plan_rader)
+{
+    // prime radices larger than rader_threshold, without a codelet
+    const M_ll g{primitive_root(12109)};
+    for (int n : {1009, 2018, 3027})
+    {
+        const M_ll e = power(g, 12108 / n);
+        std::vector<M_ll> A;
+        for (int i = 0; i < n; ++i)
+            A.emplace_back(i * i + 1);
+        const auto FT_A = FFT_BruteForce(A, e);
+
+        BOOST_TEST((FFT_Iterative(A, e) == FT_A));
+
+        plan<M_ll> P(n, e);
+        auto B = A;
+        P.forward(B.begin(), B.end());
+        BOOST_TEST((B == FT_A));
+
+        P.inverse(B.begin(), B.end());
+        const M_ll inv_n{M_ll{n}.inverse()};
+        for (auto& x : B)
+            x *= inv_n;
+        BOOST_TEST((B == A));
+    }
+    BOOST_CHECK_THROW(FFT_Rader(std::vector<M_ll>(12), M_ll{1}),
+                      fftx::error);
+}
@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE real
+#include <boost/test/unit_test.hpp>
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+using cd = std::complex<double>;
+
+const double PI = acos(-1.0);
+
+std::vector<double> random_vec(std::size_t N)
+{
+    std::default_random_engine gen(123);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<double> V(N);
+    for (auto& x : V)
+        x = distribution(gen);
+    return V;
+}
+
+BOOST_AUTO_TEST_CASE(real_throws)
+{
+    const std::vector<cd> H(3);
+    BOOST_CHECK_THROW(FFT_RealInverse(H, 6, cd{1}), fftx::error);
+    BOOST_CHECK_THROW(FFT_RealInverse(H, 0, cd{1}), fftx::error);
+}
+
+BOOST_AUTO_TEST_CASE(real_forward_inverse)
+{
+    for (int n : {1, 2, 3, 4, 5, 6, 8, 9, 14, 64, 100, 1009, 1024, 2018})
+    {
+        const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+        const auto A = random_vec(n);
+
+        // the first half of the complex transform
+        const auto FT_A =
+            FFT_BruteForce(std::vector<cd>(A.begin(), A.end()), e);
+        const auto H = FFT_Real(A, e);
+        BOOST_TEST(H.size() == std::size_t(n / 2 + 1));
+
+        double diff = 0;
+        for (std::size_t k = 0; k < H.size(); ++k)
+            diff += std::norm(H[k] - FT_A[k]);
+        BOOST_CHECK_SMALL(sqrt(diff) / n, 1e-10);
+
+        // the inverse is not normalized
+        const auto B = FFT_RealInverse(H, n, std::conj(e));
+        diff = 0;
+        for (int j = 0; j < n; ++j)
+            diff += std::pow(B[j] / n - A[j], 2);
+        BOOST_CHECK_SMALL(sqrt(diff) / n, 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(real_float)
+{
+    const int n = 256;
+    const std::complex<float> e(cos(2 * PI / n), -sin(2 * PI / n));
+    std::vector<float> A(n);
+    for (int j = 0; j < n; ++j)
+        A[j] = cos(2 * PI * 3 * j / n);
+
+    // a single cosine: X_3 = n/2
+    const auto H = FFT_Real(A, e);
+    for (int k = 0; k <= n / 2; ++k)
+        BOOST_CHECK_SMALL(std::abs(H[k] - (k == 3 ? n / 2.0f : 0.0f)),
+                          1e-3f);
+}
+
+BOOST_AUTO_TEST_CASE(real_plan_repeated)
+{
+    for (int n : {1, 7, 12, 210})
+    {
+        const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+        const auto A = random_vec(n);
+        const auto H = FFT_Real(A, e);
+
+        real_plan<double> P(n, e);
+        BOOST_TEST(P.size() == n);
+        for (int rep = 0; rep < 3; ++rep)
+        {
+            std::vector<cd> X(n / 2 + 1);
+            P.forward(A.begin(), A.end(), X.begin());
+            double diff = 0;
+            for (std::size_t k = 0; k < X.size(); ++k)
+                diff += std::norm(X[k] - H[k]);
+            BOOST_CHECK_SMALL(sqrt(diff) / n, 1e-12);
+
+            std::vector<double> B(n);
+            P.inverse(X.begin(), B.begin(), B.end());
+            diff = 0;
+            for (int j = 0; j < n; ++j)
+                diff += std::pow(B[j] / n - A[j], 2);
+            BOOST_CHECK_SMALL(sqrt(diff) / n, 1e-12);
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#define BOOST_TEST_MODULE split
+#include <boost/test/unit_test.hpp>
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <fftx.hpp>
+
+using namespace boost::unit_test;
+using namespace boost;
+using namespace fftx;
+
+using cd = std::complex<double>;
+
+const double PI = acos(-1.0);
+
+std::vector<cd> random_vec(std::size_t N)
+{
+    std::default_random_engine gen(123);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<cd> V(N);
+    for (auto& x : V)
+        x = cd(distribution(gen), distribution(gen));
+    return V;
+}
+
+BOOST_AUTO_TEST_CASE(split_conversion)
+{
+    const auto A = random_vec(37);
+    const auto S = to_split(A);
+    BOOST_TEST(S.size() == A.size());
+    for (std::size_t i = 0; i < A.size(); ++i)
+    {
+        BOOST_TEST(S.re[i] == A[i].real());
+        BOOST_TEST(S.im[i] == A[i].imag());
+        BOOST_TEST((S[i] == A[i]));
+    }
+    BOOST_TEST((from_split(S) == A));
+}
+
+BOOST_AUTO_TEST_CASE(split_radix4)
+{
+    BOOST_CHECK_THROW(FFT_Radix4_split(split_complex<double>(12), cd{1}),
+                      std::runtime_error);
+
+    for (int n : {1, 2, 4, 8, 32, 128, 1024, 4096})
+    {
+        const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+        const auto A = random_vec(n);
+
+        // same result as the interleaved engine
+        const auto FT_A = FFT_Radix4(A, e);
+        const auto B = from_split(FFT_Radix4_split(to_split(A), e));
+        double diff = 0;
+        for (int i = 0; i < n; ++i)
+            diff += std::norm(B[i] - FT_A[i]);
+        BOOST_CHECK_SMALL(sqrt(diff) / n, 1e-12);
+
+        // inverse
+        auto S = to_split(B);
+        FFT_Radix4_split(S.re.begin(), S.re.end(), S.im.begin(),
+                         std::conj(e));
+        diff = 0;
+        for (int i = 0; i < n; ++i)
+            diff += std::norm(S[i] / double(n) - A[i]);
+        BOOST_CHECK_SMALL(sqrt(diff) / n, 1e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(split_plan)
+{
+    // the fixed kernels, Bluestein, radix-4 and mixed radix sizes, the
+    // round-off of the largest ones is above 1e-12
+    for (int n : {1, 2, 3, 5, 6, 7, 12, 13, 16, 41, 64, 100, 194, 360, 1000,
+                  1155, 4096, 1 << 15, 1 << 16, 1 << 17})
+    {
+        const cd e(cos(2 * PI / n), -sin(2 * PI / n));
+        const auto A = random_vec(n);
+        plan<cd> P(n, e);
+
+        auto B = A;
+        P.forward(B.begin(), B.end());
+        auto S = to_split(A);
+        P.forward_split(S.re.begin(), S.re.end(), S.im.begin());
+        double diff = 0;
+        for (int i = 0; i < n; ++i)
+            diff += std::norm(S[i] - B[i]);
+        BOOST_CHECK_SMALL(sqrt(diff) / n, 1e-11);
+
+        P.inverse_split(S.re.begin(), S.re.end(), S.im.begin());
+        diff = 0;
+        for (int i = 0; i < n; ++i)
+            diff += std::norm(S[i] / double(n) - A[i]);
+        BOOST_CHECK_SMALL(sqrt(diff) / n, 1e-11);
+    }
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <fftx.hpp>
+#include <iostream>
+#include <random>
+
+#include <fftw3.h>
+
+using namespace std;
+using namespace fftx;
+using namespace std::chrono;
+
+typedef complex<double> cd;
+const double PI = acos(-1.0);
+default_random_engine rng;
+
+/*
+    best time of a few runs of f, in milliseconds
+*/
+template <class F>
+double best_time(F&& f)
+{
+    double best = 1e30;
+    for (int r = 0; r < 5; ++r)
+    {
+        auto t = steady_clock::now();
+        f();
+        best = min(best, duration<double, milli>(steady_clock::now() - t)
+                             .count());
+    }
+    return best;
+}
+
+int main()
+{
+    cout << "N\tfftx (ms)\tfftx par (ms)\tfftw3 (ms)\n";
+    for (int N : {16, 32, 64, 100, 128, 256, 384, 512})
+    {
+        vector<cd> A(N * N * N);
+        const cd e(cos(2 * PI / N), -sin(2 * PI / N));
+        uniform_real_distribution<double> U(0, 1);
+
+        for (auto& x : A)
+            x = cd(U(rng), U(rng));
+
+        // fft-3d
+        vector<cd> FA(A);
+        const double t1 = best_time([&] {
+            copy(A.begin(), A.end(), FA.begin());
+            FFT_dim<3>(FA.begin(), FA.end(), N, e);
+        });
+
+        // fft-3d on all the hardware threads
+        vector<cd> PA(A);
+        const double t3 = best_time([&] {
+            copy(A.begin(), A.end(), PA.begin());
+            FFT_dim<3>(execution::par, PA.begin(), PA.end(), N, e);
+        });
+
+        // fftw3-3d, the planning is not timed
+        fftw_complex* in =
+            (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * A.size());
+        fftw_complex* out =
+            (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * A.size());
+        fftw_plan p =
+            fftw_plan_dft_3d(N, N, N, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
+        const double t2 = best_time([&] {
+            for (size_t i = 0; i < A.size(); ++i)
+            {
+                in[i][0] = A[i].real();
+                in[i][1] = A[i].imag();
+            }
+            fftw_execute(p);
+        });
+
+        double diff = 0;
+        for (size_t i = 0; i < FA.size(); ++i)
+            diff = max({diff, abs(FA[i] - cd(out[i][0], out[i][1])),
+                        abs(PA[i] - FA[i])});
+
+        fftw_destroy_plan(p);
+        fftw_free(in);
+        fftw_free(out);
+
+        cout << N << '\t' << t1 << "\t\t" << t3 << "\t\t" << t2;
+        if (diff > 1e-6 * N * N * N)
+            cout << "\t(max error " << diff << ")";
+        cout << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <cmath>
+#include <complex>
+#include <fftx/mpi.hpp>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace fftx;
+
+typedef complex<double> cd;
+const double PI = acos(-1.0);
+
+/*
+    Timings of pencil_plan on N^3 volumes: per axis, the time of the FTs
+    and of the exchange that makes the axis local, the maximum over the
+    ranks of the mean over the runs.
+*/
+int main(int argc, char** argv)
+{
+    MPI_Init(&argc, &argv);
+    int size, rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    if (rank == 0)
+        cout << setw(5) << "N" << setw(8) << "grid" << setw(12) << "fft 2"
+             << setw(12) << "a2a 1" << setw(12) << "fft 1" << setw(12)
+             << "a2a 0" << setw(12) << "fft 0" << setw(12) << "total"
+             << "  (ms)" << endl;
+    for (int N : {32, 64, 128, 256})
+    {
+        const cd e = polar(1.0, -2 * PI / N);
+        pencil_plan<cd> p(MPI_COMM_WORLD, {N, N, N}, {e, e, e});
+        const auto in = p.input_size(), on = p.output_size();
+        vector<cd> x((long long)in[0] * in[1] * in[2]);
+        vector<cd> y(max<long long>(x.size(), (long long)on[0] * on[1] * on[2]));
+        default_random_engine rng(rank);
+        uniform_real_distribution<double> U(0, 1);
+        for (auto& v : x)
+            v = cd(U(rng), U(rng));
+
+        const int runs = N <= 64 ? 20 : 3;
+        p.forward(x.data(), y.data());  // warm up
+        p.reset_timings();
+        MPI_Barrier(MPI_COMM_WORLD);
+        const double t = MPI_Wtime();
+        for (int r = 0; r < runs; ++r)
+            p.forward(x.data(), y.data());
+        double total = MPI_Wtime() - t;
+
+        const auto& tm = p.timings();
+        double ms[6] = {tm.compute[2], tm.communicate[1], tm.compute[1],
+                        tm.communicate[0], tm.compute[0], total};
+        MPI_Allreduce(MPI_IN_PLACE, ms, 6, MPI_DOUBLE, MPI_MAX,
+                      MPI_COMM_WORLD);
+        if (rank == 0)
+        {
+            const auto grid = p.grid();
+            cout << setw(5) << N << setw(8)
+                 << to_string(grid[0]) + "x" + to_string(grid[1]);
+            for (double v : ms)
+                cout << setw(12) << fixed << setprecision(3)
+                     << 1e3 * v / runs;
+            cout << endl;
+        }
+    }
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <cmath>
+#include <complex>
+#include <fftx.hpp>
+#include <fftx/mpi.hpp>
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace fftx;
+
+typedef complex<double> cd;
+const double PI = acos(-1.0);
+
+/*
+    The pencil FFT of a volume known by every rank, against FFT_nd: every
+    rank checks its output block and the inverse of it.
+*/
+double check(const array<int, 3>& N, int P0, int P1)
+{
+    const long long size = (long long)N[0] * N[1] * N[2];
+    vector<cd> A(size);
+    default_random_engine rng(size);
+    uniform_real_distribution<double> U(0, 1);
+    for (auto& x : A)
+        x = cd(U(rng), U(rng));
+
+    array<cd, 3> e;
+    for (int d = 0; d < 3; ++d)
+        e[d] = polar(1.0, -2 * PI / N[d]);
+    vector<cd> FA(A);
+    FFT_nd(FA.begin(), {N[0], N[1], N[2]}, vector<cd>(e.begin(), e.end()));
+
+    pencil_plan<cd> p(MPI_COMM_WORLD, N, e, P0, P1);
+    const auto is = p.input_start(), in = p.input_size();
+    const auto os = p.output_start(), on = p.output_size();
+    vector<cd> x;
+    for (int i0 = 0; i0 < in[0]; ++i0)
+        for (int i1 = 0; i1 < in[1]; ++i1)
+            for (int i2 = 0; i2 < in[2]; ++i2)
+                x.push_back(
+                    A[((long long)(is[0] + i0) * N[1] + is[1] + i1) * N[2] + i2]);
+    vector<cd> y(max<long long>(x.size(), (long long)on[0] * on[1] * on[2]));
+    p.forward(x.data(), y.data());
+
+    double err = 0;
+    for (int k2 = 0; k2 < on[0]; ++k2)
+        for (int k1 = 0; k1 < on[1]; ++k1)
+            for (int k0 = 0; k0 < on[2]; ++k0)
+            {
+                const cd v = y[((long long)k2 * on[1] + k1) * on[2] + k0];
+                err = max(err,
+                          abs(v - FA[((long long)k0 * N[1] + os[1] + k1) * N[2] +
+                                     os[0] + k2]));
+            }
+
+    p.inverse(y.data(), y.data());
+    for (size_t i = 0; i < x.size(); ++i)
+        err = max(err, abs(y[i] / double(size) - x[i]));
+
+    MPI_Allreduce(MPI_IN_PLACE, &err, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return err;
+}
+
+int main(int argc, char** argv)
+{
+    MPI_Init(&argc, &argv);
+    int size, rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    bool ok = true;
+    const array<int, 3> shapes[] = {
+        {16, 16, 16}, {12, 10, 9}, {8, 3, 20}, {1, 7, 5}};
+    for (const auto& N : shapes)
+        for (int P0 : {0, 1, size})
+        {
+            const double err = check(N, P0, P0 ? size / P0 : 0);
+            if (rank == 0)
+                cout << N[0] << "x" << N[1] << "x" << N[2] << " P0=" << P0
+                     << ": " << err << endl;
+            ok = ok && err < 1e-9;
+        }
+
+    // grids that do not match the ranks
+    const cd i4 = polar(1.0, -PI / 2);
+    for (const auto& P : {array<int, 2>{size + 1, 1}, {2, size + 1}, {-1, 0},
+                          {size + 1, 0}, {0, size + 1}})
+        try
+        {
+            pencil_plan<cd> p(MPI_COMM_WORLD, {4, 4, 4}, {i4, i4, i4}, P[0],
+                              P[1]);
+            ok = false;
+        }
+        catch (const fftx::error&)
+        {
+        }
+
+    MPI_Finalize();
+    return ok ? 0 : 1;
+}
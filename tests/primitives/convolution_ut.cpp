@@ -35,6 +35,26 @@ struct iterative_fft
     constexpr auto size() const { return n; }
 };
 
+template <std::size_t n, class T>
+struct codelet_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        FFT_Codelet_fixed<n>(A.begin(), A.begin(), e);
+    }
+    constexpr auto size() const { return n; }
+};
+
+template <std::size_t n, class T>
+struct fixed_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        FFT_fixed<n>(A.begin(), A.begin(), e);
+    }
+    constexpr auto size() const { return n; }
+};
+
 template <std::size_t n, class T>
 struct pow2_fft
 {
@@ -45,6 +65,45 @@ struct pow2_fft
     constexpr auto size() const { return n; }
 };
 
+template <std::size_t n, class T>
+struct pow2_split_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        using R = typename T::value_type;
+        std::vector<R> re(n), im(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            re[i] = A[i].real();
+            im[i] = A[i].imag();
+        }
+        FFT_Power2_fixed_split<n>(re.begin(), im.begin(), re.begin(),
+                                  im.begin(), e);
+        for (std::size_t i = 0; i < n; ++i)
+            A[i] = T(re[i], im[i]);
+    }
+    constexpr auto size() const { return n; }
+};
+
+template <std::size_t n, class T>
+struct fixed_split_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        using R = typename T::value_type;
+        std::vector<R> re(n), im(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            re[i] = A[i].real();
+            im[i] = A[i].imag();
+        }
+        FFT_fixed_split<n>(re.begin(), im.begin(), re.begin(), im.begin(), e);
+        for (std::size_t i = 0; i < n; ++i)
+            A[i] = T(re[i], im[i]);
+    }
+    constexpr auto size() const { return n; }
+};
+
 template <class fft_type>
 void test_func_convolution(const std::vector<cd>& cA, const std::vector<cd>& cB)
 {
@@ -127,9 +186,44 @@ template <std::size_t beg, std::size_t end>
     TS.add(BOOST_TEST_CASE_NAME(
         std::bind(&test_func_convolution<pow2_fft<beg, cd>>, A, B),
         "Power2 fixed-size FFT, N=" + std::to_string(beg)));
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_convolution<pow2_split_fft<beg, cd>>, A, B),
+        "Power2 fixed-size split FFT, N=" + std::to_string(beg)));
     test_powrange<beg * 2, end>(A, B, TS);
 }
 
+template <std::size_t beg, std::size_t end>
+typename std::enable_if<beg >= end, void>::type test_linrange_codelet(
+    const std::vector<cd>& A [[maybe_unused]],
+    const std::vector<cd>& B [[maybe_unused]],
+    test_suite& TS [[maybe_unused]])
+{
+}
+template <std::size_t beg, std::size_t end>
+    typename std::enable_if <
+    beg<end, void>::type test_linrange_codelet(const std::vector<cd>& A,
+                                               const std::vector<cd>& B,
+                                               test_suite& TS)
+{
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_convolution<codelet_fft<beg, cd>>, A, B),
+        "Codelet fixed-size FFT, N=" + std::to_string(beg)));
+    test_linrange_codelet<beg + 2, end>(A, B, TS);
+}
+
+template <std::size_t n>
+void add_fixed(const std::vector<cd>& A,
+               const std::vector<cd>& B,
+               test_suite& TS)
+{
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_convolution<fixed_fft<n, cd>>, A, B),
+        "Dispatched fixed-size FFT, N=" + std::to_string(n)));
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_convolution<fixed_split_fft<n, cd>>, A, B),
+        "Dispatched fixed-size split FFT, N=" + std::to_string(n)));
+}
+
 struct convolution_test_suite : public test_suite
 {
     std::default_random_engine gen;
@@ -154,6 +248,15 @@ struct convolution_test_suite : public test_suite
 
         test_linrange<2, 12>(A, B, *this);
         test_powrange<2, 128>(A, B, *this);
+        test_linrange_codelet<2, 66>(A, B, *this);
+        add_fixed<4>(A, B, *this);
+        add_fixed<12>(A, B, *this);
+        add_fixed<64>(A, B, *this);
+        add_fixed<66>(A, B, *this);
+        add_fixed<96>(A, B, *this);
+        add_fixed<128>(A, B, *this);
+        add_fixed<210>(A, B, *this);
+        add_fixed<256>(A, B, *this);
     }
 };
 
@@ -35,6 +35,37 @@ struct iterative_fft
     constexpr auto size() const { return n; }
 };
 
+template <std::size_t n, class T>
+struct codelet_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        FFT_Codelet_fixed<n>(A.begin(), A.begin(), e);
+    }
+    constexpr auto size() const { return n; }
+};
+
+template <std::size_t n, class T>
+struct fixed_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        FFT_fixed<n>(A.begin(), A.begin(), e);
+    }
+    constexpr auto size() const { return n; }
+};
+
+// FFT_fixed with the size known at run time only
+template <std::size_t n, class T>
+struct fixed_runtime_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        FFT_fixed(A.begin(), A.end(), e);
+    }
+    constexpr auto size() const { return n; }
+};
+
 template <std::size_t n, class T>
 struct pow2_fft
 {
@@ -45,6 +76,45 @@ struct pow2_fft
     constexpr auto size() const { return n; }
 };
 
+template <std::size_t n, class T>
+struct pow2_split_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        using R = typename T::value_type;
+        std::vector<R> re(n), im(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            re[i] = A[i].real();
+            im[i] = A[i].imag();
+        }
+        FFT_Power2_fixed_split<n>(re.begin(), im.begin(), re.begin(),
+                                  im.begin(), e);
+        for (std::size_t i = 0; i < n; ++i)
+            A[i] = T(re[i], im[i]);
+    }
+    constexpr auto size() const { return n; }
+};
+
+template <std::size_t n, class T>
+struct fixed_split_fft
+{
+    void operator()(std::vector<T>& A, const T e) const
+    {
+        using R = typename T::value_type;
+        std::vector<R> re(n), im(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            re[i] = A[i].real();
+            im[i] = A[i].imag();
+        }
+        FFT_fixed_split<n>(re.begin(), im.begin(), re.begin(), im.begin(), e);
+        for (std::size_t i = 0; i < n; ++i)
+            A[i] = T(re[i], im[i]);
+    }
+    constexpr auto size() const { return n; }
+};
+
 template <std::size_t n, class T>
 struct handwritten_fft
 {
@@ -120,6 +190,9 @@ template <std::size_t beg, std::size_t end>
     TS.add(BOOST_TEST_CASE_NAME(
         std::bind(&test_func_inverse<pow2_fft<beg, cd>>, A),
         "Power2 fixed-size FFT, N=" + std::to_string(beg)));
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_inverse<pow2_split_fft<beg, cd>>, A),
+        "Power2 fixed-size split FFT, N=" + std::to_string(beg)));
     test_powrange<beg * 2, end>(A, TS);
 }
 
@@ -157,6 +230,58 @@ template <std::size_t beg, std::size_t end>
     test_linrange_bruteforce<beg + 1, end>(A, TS);
 }
 
+template <std::size_t beg, std::size_t end>
+typename std::enable_if<beg >= end, void>::type test_linrange_codelet(
+    const std::vector<cd>& A [[maybe_unused]],
+    test_suite& TS [[maybe_unused]])
+{
+}
+template <std::size_t beg, std::size_t end>
+    typename std::enable_if <
+    beg<end, void>::type test_linrange_codelet(const std::vector<cd>& A,
+                                               test_suite& TS)
+{
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_inverse<codelet_fft<beg, cd>>, A),
+        "Codelet fixed-size FFT, N=" + std::to_string(beg)));
+    test_linrange_codelet<beg + 1, end>(A, TS);
+}
+
+template <std::size_t beg, std::size_t end>
+typename std::enable_if<beg >= end, void>::type test_linrange_fixed_runtime(
+    const std::vector<cd>& A [[maybe_unused]],
+    test_suite& TS [[maybe_unused]])
+{
+}
+template <std::size_t beg, std::size_t end>
+    typename std::enable_if <
+    beg<end, void>::type test_linrange_fixed_runtime(const std::vector<cd>& A,
+                                                     test_suite& TS)
+{
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_inverse<fixed_runtime_fft<beg, cd>>, A),
+        "Run-time fixed-size FFT, N=" + std::to_string(beg)));
+    test_linrange_fixed_runtime<beg + 1, end>(A, TS);
+}
+
+template <std::size_t n>
+void add_fixed(const std::vector<cd>& A, test_suite& TS)
+{
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_inverse<fixed_fft<n, cd>>, A),
+        "Dispatched fixed-size FFT, N=" + std::to_string(n)));
+    TS.add(BOOST_TEST_CASE_NAME(
+        std::bind(&test_func_inverse<fixed_split_fft<n, cd>>, A),
+        "Dispatched fixed-size split FFT, N=" + std::to_string(n)));
+}
+
+void test_fixed_throws()
+{
+    std::vector<cd> A(fixed_limit + 1);
+    BOOST_CHECK_THROW(FFT_fixed(A.begin(), A.end(), cd(1)), fftx::error);
+    BOOST_CHECK_THROW(FFT_fixed(A.begin(), A.begin(), cd(1)), fftx::error);
+}
+
 struct inverse_test_suite : public test_suite
 {
     std::default_random_engine gen;
@@ -176,13 +301,32 @@ struct inverse_test_suite : public test_suite
           distribution(0.0, 1.0)
     {
         // fixed size
-        auto A = random_vec(128);
+        auto A = random_vec(256);
 
         test_linrange<1, 10>(A, *this);
         test_powrange<1, 128>(A, *this);
 
         test_linrange_handwritten<1, 8>(A, *this);
         test_linrange_bruteforce<1, 10>(A, *this);
+        test_linrange_codelet<1, 65>(A, *this);
+
+        test_linrange_fixed_runtime<1, 65>(A, *this);
+        add_fixed<5>(A, *this);
+        add_fixed<6>(A, *this);
+        add_fixed<65>(A, *this);
+        add_fixed<67>(A, *this);
+        add_fixed<96>(A, *this);
+        add_fixed<128>(A, *this);
+        add_fixed<210>(A, *this);
+        add_fixed<256>(A, *this);
+        add(BOOST_TEST_CASE_NAME(&test_fixed_throws, "FFT_fixed throws"));
+
+        // above fixed_table_limit: permutation on the fly, heap buffers
+        auto B = random_vec(1 << 16);
+        test_powrange<1 << 16, (1 << 16) + 1>(B, *this);
+        test_linrange<1 << 16, (1 << 16) + 1>(B, *this);
+        add_fixed<3840>(B, *this);
+        add_fixed<fixed_table_limit>(B, *this);
     }
 };
 